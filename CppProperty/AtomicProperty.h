@@ -0,0 +1,186 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// AtomicProperty.h - Lock-free properties for small values        //
+// ver 1.0 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a thread-safe property for arithmetic and
+* small trivially-copyable types that needs no mutex:
+* - is_atomic_prop_type<T>
+*     Trait that is true when std::atomic<T> is always lock-free
+* - AtomicProperty<T>
+*     Stores its value in std::atomic<T>.  Provides the same
+*     operator=(t), operator()(t), and operator()() as PropertyBase<T>,
+*     plus load, store, exchange, compare_exchange_weak/strong,
+*     and, for arithmetic types other than bool, fetch_add and fetch_sub.
+*     There are no virtual functions, so there is no vtable.
+* - TS_AutoProperty<T>
+*     Alias that selects AtomicProperty<T> when is_atomic_prop_type<T>
+*     holds, and TS_Property<T> otherwise.
+*
+* Required Files:
+* ---------------
+* AtomicProperty.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <type_traits>
+#include "Property.h"
+
+///////////////////////////////////////////////////////////////
+// is_atomic_prop_type<T>
+// - std::atomic<T> may only be instantiated for trivially
+//   copyable T, so that test has to short-circuit the
+//   lock-free test
+
+namespace is_atomic_prop_type_impl {
+
+  template <typename T, bool = std::is_trivially_copyable<T>::value>
+  struct is_atomic_prop_type : std::false_type {};
+
+  template <typename T>
+  struct is_atomic_prop_type<T, true>
+    : std::integral_constant<bool,
+        std::is_default_constructible<T>::value && std::atomic<T>::is_always_lock_free
+      > {};
+}
+
+template <typename T> struct is_atomic_prop_type {
+  static constexpr bool const value = is_atomic_prop_type_impl::is_atomic_prop_type<std::decay_t<T>>::value;
+};
+
+///////////////////////////////////////////////////////////////
+// AtomicProperty<T> class
+// - all operations are lock-free
+// - operator()() and operator()(t) use sequentially consistent
+//   ordering, like std::atomic<T>; load, store, etc. accept
+//   an explicit memory order
+
+template<typename T>
+class AtomicProperty
+{
+  static_assert(is_atomic_prop_type<T>::value,
+    "AtomicProperty<T> requires a trivially copyable T with lock-free std::atomic<T>");
+public:
+  using value_type = T;
+
+  AtomicProperty() : t_(T()) {}
+  AtomicProperty(const T& t) : t_(t) {}
+
+  AtomicProperty(const AtomicProperty<T>& prop) = delete;
+  AtomicProperty<T>& operator=(const AtomicProperty<T>& prop) = delete;
+
+  AtomicProperty<T>& operator=(const T& t)
+  {
+    t_.store(t);
+    return *this;
+  }
+  void operator()(const T& t)
+  {
+    t_.store(t);
+  }
+  T operator()() const
+  {
+    return t_.load();
+  }
+
+  T load(std::memory_order order = std::memory_order_seq_cst) const
+  {
+    return t_.load(order);
+  }
+
+  void store(const T& t, std::memory_order order = std::memory_order_seq_cst)
+  {
+    t_.store(t, order);
+  }
+
+  T exchange(const T& t, std::memory_order order = std::memory_order_seq_cst)
+  {
+    return t_.exchange(t, order);
+  }
+
+  bool compare_exchange_weak(
+    T& expected, const T& desired, std::memory_order order = std::memory_order_seq_cst
+  )
+  {
+    return t_.compare_exchange_weak(expected, desired, order);
+  }
+
+  bool compare_exchange_strong(
+    T& expected, const T& desired, std::memory_order order = std::memory_order_seq_cst
+  )
+  {
+    return t_.compare_exchange_strong(expected, desired, order);
+  }
+  //----< returns value held before adding arg >-----------
+  /*
+  *  std::atomic<T> only provides fetch_add for floating point
+  *  types as of C++20, so those use a compare-exchange loop.
+  */
+  template<typename U = T, typename std::enable_if<
+    std::is_arithmetic<U>::value && !std::is_same<U, bool>::value, U
+  >::type* = nullptr>
+  T fetch_add(const T& arg, std::memory_order order = std::memory_order_seq_cst)
+  {
+    if constexpr (std::is_integral<T>::value)
+    {
+      return t_.fetch_add(arg, order);
+    }
+    else
+    {
+      T old = t_.load(std::memory_order_relaxed);
+      while (!t_.compare_exchange_weak(old, static_cast<T>(old + arg), order, std::memory_order_relaxed))
+        ;
+      return old;
+    }
+  }
+  //----< returns value held before subtracting arg >------
+
+  template<typename U = T, typename std::enable_if<
+    std::is_arithmetic<U>::value && !std::is_same<U, bool>::value, U
+  >::type* = nullptr>
+  T fetch_sub(const T& arg, std::memory_order order = std::memory_order_seq_cst)
+  {
+    if constexpr (std::is_integral<T>::value)
+    {
+      return t_.fetch_sub(arg, order);
+    }
+    else
+    {
+      T old = t_.load(std::memory_order_relaxed);
+      while (!t_.compare_exchange_weak(old, static_cast<T>(old - arg), order, std::memory_order_relaxed))
+        ;
+      return old;
+    }
+  }
+
+  bool is_lock_free() const
+  {
+    return t_.is_lock_free();
+  }
+
+private:
+  std::atomic<T> t_;
+};
+
+///////////////////////////////////////////////////////////////
+// TS_AutoProperty<T>
+// - selects, at compile time, the lock-free property for
+//   small values and the mutex-based property for the rest
+
+template<typename T>
+using TS_AutoProperty = std::conditional_t<
+  is_atomic_prop_type<T>::value, AtomicProperty<T>, TS_Property<T>
+>;
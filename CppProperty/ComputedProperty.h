@@ -0,0 +1,155 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// ComputedProperty.h - Cached values computed from properties     //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* - ComputedProperty<R, Sources...>
+*     Holds a function f(Sources&...) returning R, and references to
+*     its source properties.  The value is computed on the first read,
+*     cached, and computed again only when some source's version()
+*     has changed since the cached value was computed.
+*     Provides operator()(), snapshot(), version(), and invalidate().
+*
+* Sources may be any properties with version(): PropertyBase and its
+* derived classes, SeqLockProperty, SnapshotProperty, and other
+* ComputedProperty instances, so computed values can be chained.
+*
+* Reading a fresh value costs one version() call per source, each an
+* atomic load, and a PublishedPtr load, see SnapshotProperty.h, and
+* takes no lock.  When readers find the value stale only one
+* of them calls f; the rest wait for and share its result.
+*
+* Required Files:
+* ---------------
+* ComputedProperty.h, SnapshotProperty.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - cached value is published through PublishedPtr, since
+*   std::atomic_load on a shared_ptr takes a pooled mutex on
+*   some standard libraries
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include "SnapshotProperty.h"
+
+///////////////////////////////////////////////////////////////
+// ComputedProperty<R, Sources...> class
+// - source versions are read before f runs, so a source
+//   written while f runs makes the result stale at once,
+//   and the next read computes again
+// - sources must outlive the computed property
+
+template<typename R, typename... Sources>
+class ComputedProperty
+{
+public:
+  using value_type = R;
+  using snapshot_type = std::shared_ptr<const R>;
+  using Function = std::function<R(Sources&...)>;
+
+  ComputedProperty(Function f, Sources&... sources)
+    : f_(std::move(f)), sources_(sources...) {}
+
+  ComputedProperty(const ComputedProperty&) = delete;
+  ComputedProperty& operator=(const ComputedProperty&) = delete;
+
+  //----< current value, computing it if stale >-------------
+
+  R operator()()
+  {
+    return *snapshot();
+  }
+  //----< current value without copying it >-----------------
+
+  snapshot_type snapshot()
+  {
+    Versions current = sourceVersions();
+    std::shared_ptr<const Entry> pEntry = published_.load();
+    if (!pEntry || pEntry->versions != current)
+      pEntry = compute();
+    return snapshot_type(pEntry, &pEntry->value);
+  }
+  //----< changes whenever any source changes >--------------
+  /*
+  *  Source versions only increase, so their sum changes when any
+  *  of them does.  Lets other computed properties use this one
+  *  as a source.
+  */
+  std::uint64_t version() const
+  {
+    Versions current = sourceVersions();
+    std::uint64_t sum = 0;
+    for (std::uint64_t v : current)
+      sum += v;
+    return sum;
+  }
+  //----< force recomputation, e.g., after f's other inputs change >--
+
+  void invalidate()
+  {
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  size_t computeCount() const
+  {
+    return computeCount_.load(std::memory_order_relaxed);
+  }
+
+private:
+  using Versions = std::array<std::uint64_t, sizeof...(Sources) + 1>;
+
+  struct Entry
+  {
+    Versions versions;
+    R value;
+  };
+
+  //----< versions of all sources, plus invalidation epoch >--
+
+  Versions sourceVersions() const
+  {
+    return std::apply([this](Sources&... sources) {
+      return Versions{ epoch_.load(std::memory_order_acquire), sources.version()... };
+    }, sources_);
+  }
+  //----< single flight: one thread computes, the rest reuse >--
+
+  std::shared_ptr<const Entry> compute()
+  {
+    std::lock_guard<std::mutex> lck(computeMtx_);
+    Versions current = sourceVersions();
+    std::shared_ptr<const Entry> pEntry = published_.load();
+    if (pEntry && pEntry->versions == current)
+      return pEntry;
+    pEntry = std::make_shared<const Entry>(Entry{ current, std::apply(f_, sources_) });
+    computeCount_.fetch_add(1, std::memory_order_relaxed);
+    published_.store(pEntry);
+    return pEntry;
+  }
+
+  Function f_;
+  std::tuple<Sources&...> sources_;
+  PublishedPtr<const Entry> published_;
+  std::atomic<std::uint64_t> epoch_ { 0 };
+  std::atomic<size_t> computeCount_ { 0 };
+  std::mutex computeMtx_;
+};
@@ -0,0 +1,307 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// LockTelemetry.h - Lock contention statistics for properties     //
+// ver 1.2 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package measures how hard each TS_Property's lock is used.
+* TS_Property only uses it when PROPERTY_TELEMETRY is defined;
+* otherwise none of this code is compiled into TS_Property.
+* - LockStats
+*     Counters for one lock: acquisitions, contended acquisitions,
+*     total wait time, maximum hold time, and a histogram of hold
+*     times in power-of-two nanosecond buckets
+* - LockProbe
+*     Wraps lock() and unlock() of a mutex, updating a LockStats.
+*     An uncontended acquisition costs a try_lock and one clock read.
+* - InstrumentedLock<Lock>
+*     Lock policy, see Property.h, that measures another policy
+*     with a LockProbe.  Shared locking is exclusive, so it suits
+*     policies, like MutexLock, that don't share.
+* - TelemetryRegistry
+*     Singleton holding the LockStats of every live instrumented
+*     property.  snapshot() copies them, dumpText(out) and
+*     dumpJson(out) write them.
+*
+* Required Files:
+* ---------------
+* LockTelemetry.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 17 Oct 2026
+* - names are set under the registry's mutex, so naming a lock
+*   doesn't race with snapshot()
+* ver 1.1 : 17 Oct 2026
+* - added InstrumentedLock<Lock> for policy-based properties
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// LockStats struct
+// - counters are atomic so snapshots can be taken while the
+//   lock is in use; they're only updated by the lock holder
+// - name is guarded by the TelemetryRegistry's mutex
+
+struct LockStats
+{
+  static constexpr size_t NumBuckets = 32;  // bucket i counts holds in [2^i, 2^(i+1)) ns
+
+  std::string name;
+  std::atomic<std::uint64_t> acquisitions { 0 };
+  std::atomic<std::uint64_t> contended { 0 };
+  std::atomic<std::uint64_t> totalWaitNs { 0 };
+  std::atomic<std::uint64_t> maxHoldNs { 0 };
+  std::array<std::atomic<std::uint64_t>, NumBuckets> holdHistogram {};
+};
+
+///////////////////////////////////////////////////////////////
+// LockStatsSnapshot struct
+// - plain copy of LockStats
+
+struct LockStatsSnapshot
+{
+  std::string name;
+  std::uint64_t acquisitions;
+  std::uint64_t contended;
+  std::uint64_t totalWaitNs;
+  std::uint64_t maxHoldNs;
+  std::array<std::uint64_t, LockStats::NumBuckets> holdHistogram;
+};
+
+///////////////////////////////////////////////////////////////
+// TelemetryRegistry class
+
+class TelemetryRegistry
+{
+public:
+  static TelemetryRegistry& instance()
+  {
+    static TelemetryRegistry registry;
+    return registry;
+  }
+
+  void add(std::shared_ptr<LockStats> pStats)
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stats_.push_back(std::move(pStats));
+  }
+
+  void rename(LockStats* pStats, const std::string& name)
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    pStats->name = name;
+  }
+
+  void remove(const LockStats* pStats)
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stats_.erase(
+      std::remove_if(stats_.begin(), stats_.end(),
+        [pStats](const std::shared_ptr<LockStats>& p) { return p.get() == pStats; }),
+      stats_.end()
+    );
+  }
+
+  std::vector<LockStatsSnapshot> snapshot()
+  {
+    std::vector<LockStatsSnapshot> snaps;
+    std::lock_guard<std::mutex> lck(mtx_);
+    snaps.reserve(stats_.size());
+    for (auto& pStats : stats_)
+    {
+      LockStatsSnapshot snap;
+      snap.name = pStats->name;
+      snap.acquisitions = pStats->acquisitions.load(std::memory_order_relaxed);
+      snap.contended = pStats->contended.load(std::memory_order_relaxed);
+      snap.totalWaitNs = pStats->totalWaitNs.load(std::memory_order_relaxed);
+      snap.maxHoldNs = pStats->maxHoldNs.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < LockStats::NumBuckets; ++i)
+        snap.holdHistogram[i] = pStats->holdHistogram[i].load(std::memory_order_relaxed);
+      snaps.push_back(std::move(snap));
+    }
+    return snaps;
+  }
+
+  void dumpText(std::ostream& out)
+  {
+    for (auto& snap : snapshot())
+    {
+      out << "\n  " << (snap.name.empty() ? "(unnamed)" : snap.name)
+        << ": acquisitions = " << snap.acquisitions
+        << ", contended = " << snap.contended
+        << ", wait = " << snap.totalWaitNs << " ns"
+        << ", max hold = " << snap.maxHoldNs << " ns";
+      out << "\n    hold histogram, counts per range:";
+      for (size_t i = 0; i < LockStats::NumBuckets; ++i)
+      {
+        if (snap.holdHistogram[i] != 0)
+          out << " [" << (std::uint64_t(1) << i) << ", " << (std::uint64_t(1) << (i + 1)) << ") ns: " << snap.holdHistogram[i];
+      }
+    }
+  }
+
+  void dumpJson(std::ostream& out)
+  {
+    out << "[";
+    bool first = true;
+    for (auto& snap : snapshot())
+    {
+      out << (first ? "" : ",") << "\n  { \"name\": \"" << jsonEscape(snap.name) << "\""
+        << ", \"acquisitions\": " << snap.acquisitions
+        << ", \"contended\": " << snap.contended
+        << ", \"totalWaitNs\": " << snap.totalWaitNs
+        << ", \"maxHoldNs\": " << snap.maxHoldNs
+        << ", \"holdHistogram\": [";
+      for (size_t i = 0; i < LockStats::NumBuckets; ++i)
+        out << (i == 0 ? "" : ", ") << snap.holdHistogram[i];
+      out << "] }";
+      first = false;
+    }
+    out << "\n]";
+  }
+
+private:
+  TelemetryRegistry() {}
+
+  static std::string jsonEscape(const std::string& str)
+  {
+    std::string escaped;
+    for (char ch : str)
+    {
+      if (ch == '"' || ch == '\\')
+        escaped += '\\';
+      if (static_cast<unsigned char>(ch) < 0x20)
+        continue;
+      escaped += ch;
+    }
+    return escaped;
+  }
+
+  std::mutex mtx_;
+  std::vector<std::shared_ptr<LockStats>> stats_;
+};
+
+///////////////////////////////////////////////////////////////
+// LockProbe class
+// - hold time is measured from outermost lock() to outermost
+//   unlock(), so it works with recursive mutexes
+// - depth_ and holdStart_ are only touched by the lock holder
+
+class LockProbe
+{
+public:
+  LockProbe() : pStats_(std::make_shared<LockStats>())
+  {
+    TelemetryRegistry::instance().add(pStats_);
+  }
+  ~LockProbe()
+  {
+    TelemetryRegistry::instance().remove(pStats_.get());
+  }
+  LockProbe(const LockProbe&) = delete;
+  LockProbe& operator=(const LockProbe&) = delete;
+
+  void name(const std::string& name)
+  {
+    TelemetryRegistry::instance().rename(pStats_.get(), name);
+  }
+
+  template<typename Mutex>
+  void lock(Mutex& mtx)
+  {
+    if (!mtx.try_lock())
+    {
+      Clock::time_point start = Clock::now();
+      mtx.lock();
+      std::uint64_t waitNs = nanoseconds(Clock::now() - start);
+      pStats_->contended.fetch_add(1, std::memory_order_relaxed);
+      pStats_->totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+    }
+    if (depth_++ == 0)
+    {
+      pStats_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+      holdStart_ = Clock::now();
+    }
+  }
+
+  template<typename Mutex>
+  void unlock(Mutex& mtx)
+  {
+    if (--depth_ == 0)
+    {
+      std::uint64_t holdNs = nanoseconds(Clock::now() - holdStart_);
+      size_t bucket = 0;
+      while (bucket + 1 < LockStats::NumBuckets && (holdNs >> (bucket + 1)) != 0)
+        ++bucket;
+      pStats_->holdHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+      if (holdNs > pStats_->maxHoldNs.load(std::memory_order_relaxed))
+        pStats_->maxHoldNs.store(holdNs, std::memory_order_relaxed);
+    }
+    mtx.unlock();
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  static std::uint64_t nanoseconds(Clock::duration d)
+  {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+  }
+
+  std::shared_ptr<LockStats> pStats_;
+  size_t depth_ = 0;
+  Clock::time_point holdStart_;
+};
+
+///////////////////////////////////////////////////////////////
+// InstrumentedLock<Lock> class
+// - Lock must provide try_lock(), lock(), and unlock()
+
+template<typename Lock>
+class InstrumentedLock
+{
+public:
+  void lock()
+  {
+    probe_.lock(lock_);
+  }
+  void unlock()
+  {
+    probe_.unlock(lock_);
+  }
+  void lock_shared()
+  {
+    lock();
+  }
+  void unlock_shared()
+  {
+    unlock();
+  }
+  void name(const std::string& name)
+  {
+    probe_.name(name);
+  }
+private:
+  Lock lock_;
+  LockProbe probe_;
+};
@@ -0,0 +1,681 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// MappedVectorProperty.h - Vector property held in a mapped file  //
+// ver 1.2 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package holds large arrays of trivially copyable records in
+* memory-mapped files, so they needn't fit in RAM:
+* - MappedVector<T>
+*     A std::vector-like container whose elements live in a file
+*     mapped into memory.  The OS pages cold elements out and back
+*     in on demand, and reopening the file maps the existing
+*     elements instead of reading them.  Grows by doubling the file
+*     and remapping it.  Default constructed and copied instances
+*     use anonymous memory, backed by the paging file.
+*     Provides the std::vector operations the sequence PropertyOps
+*     uses, plus flush() and path().
+* - MappedVectorProperty<T, Lock>
+*     PropertyOps<MappedVector<T>, Lock>, thread-safe by default,
+*     constructed from a file path.  Has the same push_back,
+*     operator[], size, begin, end, append, erase, ... operations
+*     as TS_Property<std::vector<T>>.
+*
+* The file starts with a 64 byte header holding the element size and
+* count, so reopening with a different T fails instead of misreading
+* the elements.  Elements are in the machine's own byte order.
+* Changes reach the file when the OS writes pages back, or at once
+* with flush().  Growing remaps the file, so, as with std::vector,
+* pointers and iterators into it are invalidated.  Moving a vector
+* into the property replaces its file; assigning copies the elements
+* into it.
+*
+* Required Files:
+* ---------------
+* MappedVectorProperty.h, Property.h, CustomContTypeTraits.h,
+* Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 17 Oct 2026
+* - flush() holds the property's shared lock with a ReadGuard
+* ver 1.1 : 17 Oct 2026
+* - a constructor that fails to open its file no longer leaks the
+*   file and mapping
+* - a failed remap restores the old mapping, or empties the vector
+*   if it can't, instead of leaving elements counted but unmapped
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "Property.h"
+
+///////////////////////////////////////////////////////////////
+// MappedVector<T> class
+// - the element count is kept in the mapped header, so it
+//   reaches the file with the elements
+// - iterators are pointers, so algorithms and the parallel
+//   and numeric packages run at full speed over the elements
+
+template<typename T>
+class MappedVector
+{
+  static_assert(std::is_trivially_copyable<T>::value, "MappedVector<T> requires a trivially copyable T");
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  MappedVector() {}
+
+  explicit MappedVector(const std::string& path) : path_(path)
+  {
+    try
+    {
+      open();
+    }
+    catch (...)
+    {
+      unmap();
+      closeFile();
+      throw;
+    }
+  }
+
+  MappedVector(std::initializer_list<T> items)
+  {
+    insert(end(), items.begin(), items.end());
+  }
+
+  MappedVector(const MappedVector& other)
+  {
+    insert(end(), other.begin(), other.end());
+  }
+
+  MappedVector(MappedVector&& other) noexcept
+  {
+    swap(other);
+  }
+
+  ~MappedVector()
+  {
+    unmap();
+    closeFile();
+  }
+  //----< copies elements, keeping this vector's file >------
+
+  MappedVector& operator=(const MappedVector& other)
+  {
+    if (this != &other)
+      assign(other.begin(), other.end());
+    return *this;
+  }
+  //----< takes other's file, or its memory >----------------
+
+  MappedVector& operator=(MappedVector&& other) noexcept
+  {
+    if (this != &other)
+    {
+      MappedVector temp(std::move(other));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  void swap(MappedVector& other) noexcept
+  {
+    std::swap(path_, other.path_);
+    std::swap(pBase_, other.pBase_);
+    std::swap(mappedBytes_, other.mappedBytes_);
+    std::swap(count_, other.count_);
+    std::swap(capacity_, other.capacity_);
+#ifdef _WIN32
+    std::swap(file_, other.file_);
+    std::swap(mapping_, other.mapping_);
+#else
+    std::swap(fd_, other.fd_);
+#endif
+  }
+
+  //----< element access >-----------------------------------
+
+  T* data() { return pBase_ ? reinterpret_cast<T*>(pBase_ + HeaderSize) : nullptr; }
+  const T* data() const { return pBase_ ? reinterpret_cast<const T*>(pBase_ + HeaderSize) : nullptr; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + count_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + count_; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  T& operator[](size_t n) { return data()[n]; }
+  const T& operator[](size_t n) const { return data()[n]; }
+
+  T& front() { return data()[0]; }
+  const T& front() const { return data()[0]; }
+  T& back() { return data()[count_ - 1]; }
+  const T& back() const { return data()[count_ - 1]; }
+
+  size_t size() const { return count_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return count_ == 0; }
+  const std::string& path() const { return path_; }
+
+  //----< modifiers >----------------------------------------
+
+  void push_back(const T& t)
+  {
+    T item = t;  // t may be an element, moved by remapping
+    grow(count_ + 1);
+    data()[count_] = item;
+    setCount(count_ + 1);
+  }
+
+  void push_back(T&& t)
+  {
+    push_back(static_cast<const T&>(t));
+  }
+
+  template<typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    T item(std::forward<Args>(args)...);
+    push_back(item);
+    return back();
+  }
+
+  void pop_back()
+  {
+    setCount(count_ - 1);
+  }
+
+  iterator insert(const_iterator pos, const T& t)
+  {
+    size_t index = static_cast<size_t>(pos - begin());
+    T item = t;
+    grow(count_ + 1);
+    T* p = data() + index;
+    std::memmove(p + 1, p, (count_ - index) * sizeof(T));
+    *p = item;
+    setCount(count_ + 1);
+    return p;
+  }
+
+  template<typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args)
+  {
+    return insert(pos, T(std::forward<Args>(args)...));
+  }
+  //----< insert a range, copying it first if it's our own >--
+
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last)
+  {
+    size_t index = static_cast<size_t>(pos - begin());
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value)
+    {
+      if constexpr (std::is_pointer<InputIt>::value)
+      {
+        std::less<const T*> before;
+        if (first != last && !before(first, begin()) && before(first, end()))
+        {
+          std::vector<T> items(first, last);
+          return insert(pos, items.begin(), items.end());
+        }
+      }
+      size_t n = static_cast<size_t>(std::distance(first, last));
+      grow(count_ + n);
+      T* p = data() + index;
+      std::memmove(p + n, p, (count_ - index) * sizeof(T));
+      std::uninitialized_copy(first, last, p);
+      setCount(count_ + n);
+    }
+    else
+    {
+      std::vector<T> items(first, last);
+      insert(begin() + index, items.begin(), items.end());
+    }
+    return begin() + index;
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> items)
+  {
+    return insert(pos, items.begin(), items.end());
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    size_t index = static_cast<size_t>(first - begin());
+    size_t n = static_cast<size_t>(last - first);
+    T* p = data() + index;
+    std::memmove(p, p + n, (count_ - index - n) * sizeof(T));
+    setCount(count_ - n);
+    return p;
+  }
+
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void assign(InputIt first, InputIt last)
+  {
+    clear();
+    insert(end(), first, last);
+  }
+
+  void assign(std::initializer_list<T> items)
+  {
+    assign(items.begin(), items.end());
+  }
+
+  void resize(size_t n)
+  {
+    if (n > count_)
+    {
+      reserve(n);
+      std::uninitialized_value_construct(data() + count_, data() + n);
+    }
+    setCount(n);
+  }
+
+  void resize(size_t n, const T& t)
+  {
+    T item = t;
+    if (n > count_)
+    {
+      reserve(n);
+      std::uninitialized_fill(data() + count_, data() + n, item);
+    }
+    setCount(n);
+  }
+
+  void clear()
+  {
+    setCount(0);
+  }
+  //----< remap to hold at least n elements >----------------
+
+  void reserve(size_t n)
+  {
+    if (n > capacity_)
+      remap(n);
+  }
+  //----< shrink the file, or memory, to the elements held >--
+
+  void shrink_to_fit()
+  {
+    if (pBase_ != nullptr && capacity_ > count_)
+      remap(std::max<size_t>(count_, 1));
+  }
+  //----< write changed pages to the file now >--------------
+
+  void flush()
+  {
+    if (pBase_ == nullptr || path_.empty())
+      return;
+    size_t bytes = HeaderSize + count_ * sizeof(T);
+#ifdef _WIN32
+    if (!FlushViewOfFile(pBase_, bytes) || !FlushFileBuffers(file_))
+      throw std::runtime_error("exception: can't flush " + path_);
+#else
+    if (::msync(pBase_, bytes, MS_SYNC) != 0)
+      throw std::runtime_error("exception: can't flush " + path_);
+#endif
+  }
+
+  bool operator==(const MappedVector& other) const
+  {
+    return count_ == other.count_ && std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const MappedVector& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  static constexpr size_t HeaderSize = 64;
+  static constexpr char Magic[4] = { 'P', 'M', 'V', 'F' };
+  static constexpr std::uint32_t FormatVersion = 1;
+
+  struct Header
+  {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t elementSize;
+    std::uint32_t reserved;
+    std::uint64_t count;
+  };
+
+  Header* header() { return reinterpret_cast<Header*>(pBase_); }
+
+  void setCount(size_t n)
+  {
+    count_ = n;
+    if (pBase_ != nullptr)
+      header()->count = n;
+  }
+  //----< double capacity, so n pushes cost log n remaps >---
+
+  void grow(size_t n)
+  {
+    if (n > capacity_)
+    {
+      size_t minimum = std::max<size_t>(1, 4096 / sizeof(T));
+      remap(std::max({ n, 2 * capacity_, minimum }));
+    }
+  }
+  //----< map an existing file, or initialize a new one >----
+
+  void open()
+  {
+    size_t bytes = openFile();
+    if (bytes == 0)
+    {
+      remap(std::max<size_t>(1, 4096 / sizeof(T)));
+      Header* pHeader = header();
+      std::memcpy(pHeader->magic, Magic, sizeof(Magic));
+      pHeader->version = FormatVersion;
+      pHeader->elementSize = static_cast<std::uint32_t>(sizeof(T));
+      pHeader->reserved = 0;
+      setCount(0);
+      return;
+    }
+    if (bytes < HeaderSize)
+      throw std::runtime_error("exception: " + path_ + " is not a mapped vector");
+    mapView(bytes);
+    Header* pHeader = header();
+    capacity_ = (bytes - HeaderSize) / sizeof(T);
+    if (std::memcmp(pHeader->magic, Magic, sizeof(Magic)) != 0 || pHeader->version != FormatVersion
+      || pHeader->elementSize != sizeof(T) || pHeader->count > capacity_)
+      throw std::runtime_error("exception: " + path_ + " doesn't hold this element type");
+    count_ = static_cast<size_t>(pHeader->count);
+  }
+  //----< move elements to a mapping of the new capacity >---
+  /*
+  *  A file is unmapped, resized, and mapped again; its pages
+  *  stay in the OS cache, so nothing is copied.  Anonymous
+  *  memory is copied to the new mapping.  On failure the old
+  *  mapping is kept, or restored; if a file can't be mapped
+  *  again at all the vector is left empty.
+  */
+  void remap(size_t capacity)
+  {
+    size_t bytes = HeaderSize + capacity * sizeof(T);
+    if (!path_.empty())
+    {
+      size_t oldBytes = mappedBytes_;
+      unmap();
+      try
+      {
+        resizeFile(bytes);
+        mapView(bytes);
+      }
+      catch (...)
+      {
+        restoreView(oldBytes);
+        throw;
+      }
+    }
+    else
+    {
+      char* pOld = pBase_;
+      size_t oldBytes = mappedBytes_;
+#ifdef _WIN32
+      HANDLE oldMapping = mapping_;
+#endif
+      try
+      {
+        mapView(bytes);
+      }
+      catch (...)
+      {
+        pBase_ = pOld;
+        mappedBytes_ = oldBytes;
+#ifdef _WIN32
+        mapping_ = oldMapping;
+#endif
+        throw;
+      }
+      if (pOld != nullptr)
+        std::memcpy(pBase_, pOld, HeaderSize + count_ * sizeof(T));
+#ifdef _WIN32
+      UnmapViewOfFile(pOld);
+      if (oldMapping != nullptr)
+        CloseHandle(oldMapping);
+#else
+      if (pOld != nullptr)
+        ::munmap(pOld, oldBytes);
+#endif
+      (void)oldBytes;
+    }
+    capacity_ = capacity;
+  }
+  //----< map the file at its old size after a failed remap >--
+
+  void restoreView(size_t bytes) noexcept
+  {
+    if (bytes != 0)
+    {
+      try
+      {
+        resizeFile(bytes);
+        mapView(bytes);
+        return;
+      }
+      catch (...) {}
+    }
+    count_ = 0;
+    capacity_ = 0;
+  }
+
+  //----< platform specific file and mapping operations >----
+
+#ifdef _WIN32
+  size_t openFile()
+  {
+    file_ = CreateFileA(path_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+      OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+      throw std::runtime_error("exception: can't open " + path_);
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size))
+      throw std::runtime_error("exception: can't size " + path_);
+    return static_cast<size_t>(size.QuadPart);
+  }
+
+  void resizeFile(size_t bytes)
+  {
+    LARGE_INTEGER size;
+    size.QuadPart = static_cast<LONGLONG>(bytes);
+    if (!SetFilePointerEx(file_, size, nullptr, FILE_BEGIN) || !SetEndOfFile(file_))
+      throw std::runtime_error("exception: can't resize " + path_);
+  }
+  //----< file mapping, or paging file backed if no file >---
+
+  void mapView(size_t bytes)
+  {
+    std::uint64_t size = bytes;
+    mapping_ = CreateFileMappingA(path_.empty() ? INVALID_HANDLE_VALUE : file_, nullptr, PAGE_READWRITE,
+      static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    if (mapping_ == nullptr)
+      throw std::bad_alloc();
+    pBase_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, bytes));
+    if (pBase_ == nullptr)
+    {
+      CloseHandle(mapping_);
+      mapping_ = nullptr;
+      throw std::bad_alloc();
+    }
+    mappedBytes_ = bytes;
+  }
+
+  void unmap()
+  {
+    if (pBase_ != nullptr)
+      UnmapViewOfFile(pBase_);
+    if (mapping_ != nullptr)
+      CloseHandle(mapping_);
+    pBase_ = nullptr;
+    mapping_ = nullptr;
+    mappedBytes_ = 0;
+  }
+
+  void closeFile()
+  {
+    if (file_ != INVALID_HANDLE_VALUE)
+      CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+  }
+
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#else
+  size_t openFile()
+  {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0)
+      throw std::runtime_error("exception: can't open " + path_);
+    struct stat info;
+    if (::fstat(fd_, &info) != 0)
+      throw std::runtime_error("exception: can't size " + path_);
+    return static_cast<size_t>(info.st_size);
+  }
+
+  void resizeFile(size_t bytes)
+  {
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0)
+      throw std::runtime_error("exception: can't resize " + path_);
+  }
+  //----< shared file mapping, or anonymous if no file >-----
+
+  void mapView(size_t bytes)
+  {
+    void* p = path_.empty()
+      ? ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+      : ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED)
+      throw std::bad_alloc();
+    pBase_ = static_cast<char*>(p);
+    mappedBytes_ = bytes;
+  }
+
+  void unmap()
+  {
+    if (pBase_ != nullptr)
+      ::munmap(pBase_, mappedBytes_);
+    pBase_ = nullptr;
+    mappedBytes_ = 0;
+  }
+
+  void closeFile()
+  {
+    if (fd_ >= 0)
+      ::close(fd_);
+    fd_ = -1;
+  }
+
+  int fd_ = -1;
+#endif
+
+  std::string path_;
+  char* pBase_ = nullptr;
+  size_t mappedBytes_ = 0;
+  size_t count_ = 0;
+  size_t capacity_ = 0;
+};
+
+///////////////////////////////////////////////////////////////
+// sequence container trait
+// - selects the sequence PropertyOps specialization, and the
+//   sequence paths of SnapshotEncoding.h and PropertyJournal.h
+
+namespace is_stl_seq_container_impl {
+  template <typename T> struct is_stl_seq_container<MappedVector<T>> :std::true_type {};
+}
+
+///////////////////////////////////////////////////////////////
+// MappedVectorProperty<T, Lock> class
+// - thread-safe like TS_Property<std::vector<T>> with the
+//   default lock
+// - as with std::vector, indexing and iteration need to be
+//   embedded between lock() and unlock() calls
+
+template<typename T, typename Lock = TS_PropertyLock>
+class MappedVectorProperty : public PropertyOps<MappedVector<T>, Lock>
+{
+public:
+  MappedVectorProperty() {}
+  explicit MappedVectorProperty(const std::string& path)
+  {
+    this->set(MappedVector<T>(path));
+  }
+  MappedVectorProperty(const MappedVector<T>& t)
+  {
+    this->set(t);
+  }
+  MappedVectorProperty(MappedVector<T>&& t)
+  {
+    this->set(std::move(t));
+  }
+  ~MappedVectorProperty() {}
+
+  void operator=(const MappedVector<T>& t)
+  {
+    this->set(t);
+  }
+  void operator=(MappedVector<T>&& t)
+  {
+    this->set(std::move(t));
+  }
+  //----< write changed elements to the file now >-----------
+
+  void flush()
+  {
+    typename PropertyOps<MappedVector<T>, Lock>::ReadGuard lck(*this);
+    this->get().flush();
+  }
+};
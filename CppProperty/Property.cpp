@@ -1,13 +1,155 @@
 // Property.cpp
 
 #include "Property.h"
+#include "AtomicProperty.h"
+#include "SeqLockProperty.h"
+#include "SnapshotProperty.h"
+#include "ShardedProperty.h"
+#include "QueueProperty.h"
+#include "RingBufferProperty.h"
+#include "PropertyTable.h"
+#include "PropertyNumerics.h"
+#include "PropertyParallel.h"
+#include "ComputedProperty.h"
+#include "PropertyBinding.h"
+#include "PropertySnapshot.h"
+#include "MappedVectorProperty.h"
 #include <iostream>
 #include <vector>
 #include <deque>
+#include <list>
 #include <stack>
 #include <unordered_map>
+#include <map>
+#include <iomanip>
+#include <cstdint>
+#include <algorithm>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
 #include <type_traits>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <cstdlib>
+#include <new>
 
+///////////////////////////////////////////////////////////////
+// Timing helpers
+// - each timing runs a fixed number of operations, so runs on
+//   different builds and machines can be compared
+// - results feed benchSink, so the optimizer can't discard
+//   the operations being timed
+
+using BenchClock = std::chrono::steady_clock;
+
+std::atomic<long long> benchSink { 0 };
+
+//----< count heap allocations, for the footprint timing >------
+/*
+*  GCC inlines the replaced delete and then mistakes its free
+*  for a mismatch with new.
+*/
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+std::atomic<size_t> allocations { 0 };
+
+void* operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+  std::free(p);
+}
+
+double secondsSince(BenchClock::time_point start)
+{
+  return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+//----< call f(i) for i in [0, n), return calls per second >----
+
+template<typename F>
+double opsPerSec(size_t n, F f)
+{
+  long long sink = 0;
+  BenchClock::time_point start = BenchClock::now();
+  for (size_t i = 0; i < n; ++i)
+  {
+    if constexpr (std::is_void<decltype(f(i))>::value)
+      f(i);
+    else
+      sink += static_cast<long long>(f(i));
+  }
+  double seconds = secondsSince(start);
+  benchSink += sink;
+  return n / seconds;
+}
+//----< threads each call f(thread, i) n times, return total calls per second >--
+/*
+*  Threads start together, after all have been created, so thread
+*  creation isn't timed.
+*/
+template<typename F>
+double opsPerSecOn(size_t threads, size_t n, F f)
+{
+  std::atomic<size_t> ready { 0 };
+  std::atomic<bool> go { false };
+  std::vector<std::thread> runners;
+  for (size_t t = 0; t < threads; ++t)
+  {
+    runners.push_back(std::thread([&, t]() {
+      ++ready;
+      while (!go.load())
+        std::this_thread::yield();
+      long long sink = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        if constexpr (std::is_void<decltype(f(t, i))>::value)
+          f(t, i);
+        else
+          sink += static_cast<long long>(f(t, i));
+      }
+      benchSink += sink;
+    }));
+  }
+  while (ready.load() < threads)
+    std::this_thread::yield();
+  BenchClock::time_point start = BenchClock::now();
+  go.store(true);
+  for (auto& runner : runners)
+    runner.join();
+  return threads * n / secondsSince(start);
+}
+//----< 1, 2, 4, ... threads, up to the hardware's and at least 4 >--
+
+std::vector<size_t> threadCounts()
+{
+  size_t most = std::min<size_t>(16, std::max<size_t>(4, std::thread::hardware_concurrency()));
+  std::vector<size_t> counts;
+  for (size_t n = 1; n <= most; n *= 2)
+    counts.push_back(n);
+  return counts;
+}
+//----< print a rate in millions of operations per second >-----
+
+void showRate(const std::string& label, double ops)
+{
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(2) << std::setw(9) << ops / 1e6 << " M ops/sec";
+  std::cout << "\n  " << std::left << std::setw(48) << label << std::right << out.str();
+}
 
 int main()
 {
@@ -228,6 +370,1186 @@ int main()
   TS_UnordMap1.editItem(key, "foobar");
   show("TS_UnordMap1", TS_UnordMap1());
 
+  std::cout << "\n\n  Testing RW_Property<std::unordered_map<std::string, std::string>>";
+  std::cout << "\n -------------------------------------------------------------------";
+  RW_Property<std::unordered_map<std::string, std::string>> RW_UnordMap1;
+  RW_UnordMap1.insert(item1);
+  RW_UnordMap1.insert(item2);
+  RW_UnordMap1.editItem("three", "3");
+  show("RW_UnordMap1", RW_UnordMap1());
+
+  std::cout << "\n\n  four reader threads calling contains(\"two\") and size() concurrently";
+  std::vector<std::thread> readers;
+  std::vector<size_t> hits(4, 0);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    readers.push_back(std::thread([&RW_UnordMap1, &hits, i]() {
+      for (int j = 0; j < 1000; ++j)
+      {
+        if (RW_UnordMap1.contains("two") && RW_UnordMap1.size() == 3)
+          ++hits[i];
+      }
+    }));
+  }
+  RW_UnordMap1.editItem("two", "22");  // writer takes exclusive lock
+  for (auto& reader : readers)
+    reader.join();
+  for (size_t i = 0; i < 4; ++i)
+    std::cout << "\n  reader " << i << " hits = " << hits[i];
+  std::cout << "\n  RW_UnordMap1[\"two\"] = " << RW_UnordMap1["two"];
+
+  std::cout << "\n\n  Testing AtomicProperty<int>";
+  std::cout << "\n -----------------------------";
+  AtomicProperty<int> A_iProp1(6);
+  A_iProp1 = A_iProp1() + 1;
+  std::cout << "\n  A_iProp1 = " << A_iProp1();
+  std::cout << "\n  A_iProp1.is_lock_free() = " << std::boolalpha << A_iProp1.is_lock_free();
+
+  std::cout << "\n\n  four threads each calling A_iProp1.fetch_add(1) 1000 times";
+  std::vector<std::thread> adders;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    adders.push_back(std::thread([&A_iProp1]() {
+      for (int j = 0; j < 1000; ++j)
+        A_iProp1.fetch_add(1);
+    }));
+  }
+  for (auto& adder : adders)
+    adder.join();
+  std::cout << "\n  A_iProp1 = " << A_iProp1();
+
+  int expected = A_iProp1();
+  bool swapped = A_iProp1.compare_exchange_strong(expected, -1);
+  std::cout << "\n  compare_exchange_strong(" << expected << ", -1) returned " << swapped;
+  std::cout << "\n  A_iProp1.exchange(3) returned " << A_iProp1.exchange(3);
+  std::cout << "\n  A_iProp1 = " << A_iProp1();
+
+  AtomicProperty<double> A_dProp1(1.5);
+  A_dProp1.fetch_add(0.25);
+  std::cout << "\n  A_dProp1 = " << A_dProp1();
+
+  TS_AutoProperty<double> Auto_dProp1(2.5);
+  TS_AutoProperty<std::vector<int>> Auto_viProp1;
+  Auto_viProp1.push_back(1);
+  std::cout << "\n  TS_AutoProperty<double> is AtomicProperty<double>: "
+    << std::is_same<TS_AutoProperty<double>, AtomicProperty<double>>::value;
+  std::cout << "\n  TS_AutoProperty<std::vector<int>> is TS_Property<std::vector<int>>: "
+    << std::is_same<TS_AutoProperty<std::vector<int>>, TS_Property<std::vector<int>>>::value;
+  std::cout << std::noboolalpha;
+
+  std::cout << "\n\n  Testing SeqLockProperty<Position>";
+  std::cout << "\n -----------------------------------";
+  struct Position { double x, y, z; };
+  SeqLockProperty<Position> SL_PosProp1(Position{ 1.0, 2.0, 3.0 });
+  Position pos = SL_PosProp1();
+  std::cout << "\n  SL_PosProp1 = { " << pos.x << ", " << pos.y << ", " << pos.z << " }";
+
+  std::cout << "\n\n  one writer storing { i, 2i, 3i }, three readers checking for torn values";
+  std::atomic<bool> done = false;
+  std::vector<size_t> torn(3, 0);
+  std::vector<std::thread> posReaders;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    posReaders.push_back(std::thread([&SL_PosProp1, &done, &torn, i]() {
+      while (!done)
+      {
+        Position p = SL_PosProp1();
+        if (p.y != 2 * p.x || p.z != 3 * p.x)
+          ++torn[i];
+      }
+    }));
+  }
+  for (int i = 0; i < 10000; ++i)
+  {
+    double x = static_cast<double>(i);
+    SL_PosProp1 = Position{ x, 2 * x, 3 * x };
+  }
+  done = true;
+  for (auto& reader : posReaders)
+    reader.join();
+  for (size_t i = 0; i < 3; ++i)
+    std::cout << "\n  reader " << i << " saw " << torn[i] << " torn values";
+  pos = SL_PosProp1.load();
+  std::cout << "\n  SL_PosProp1 = { " << pos.x << ", " << pos.y << ", " << pos.z << " }";
+
+  std::cout << "\n\n  Testing SnapshotProperty<std::unordered_map<std::string, std::string>>";
+  std::cout << "\n -------------------------------------------------------------------------";
+  SnapshotProperty<std::unordered_map<std::string, std::string>> SP_UnordMap1;
+  SP_UnordMap1.modify([&](std::unordered_map<std::string, std::string>& map) {
+    map.insert(item1);
+    map.insert(item2);
+  });
+  auto snap1 = SP_UnordMap1();
+  show("*snap1", *snap1);
+
+  std::cout << "\n\n  SP_UnordMap1.modify(...) inserting { \"three\", \"3\" }";
+  size_t newSize = SP_UnordMap1.modify([&](std::unordered_map<std::string, std::string>& map) {
+    map.insert(item3);
+    return map.size();
+  });
+  std::cout << "\n  modify returned size " << newSize;
+  show("*SP_UnordMap1.snapshot()", *SP_UnordMap1.snapshot());
+  show("*snap1 is unchanged", *snap1);
+
+  std::cout << "\n\n  Testing batched operations on TS_Property<std::vector<int>>";
+  std::cout << "\n -------------------------------------------------------------";
+  TS_Property<std::vector<int>> TS_PropVi3;
+  std::cout << "\n  TS_PropVi3.modify(...) pushing back 1000 items under one lock";
+  TS_PropVi3.modify([](std::vector<int>& v) {
+    for (int i = 0; i < 1000; ++i)
+      v.push_back(i);
+  });
+  long long total = TS_PropVi3.read([](const std::vector<int>& v) {
+    long long sum = 0;
+    for (int item : v)
+      sum += item;
+    return sum;
+  });
+  std::cout << "\n  TS_PropVi3.read(...) summed items: " << total;
+  {
+    TS_Property<std::vector<int>>::WriteScope batch(TS_PropVi3);
+    batch->resize(3);
+    (*batch)[0] = -1;
+    batch.commit();
+  }
+  show("after WriteScope resize(3), [0] = -1, TS_PropVi3:", TS_PropVi3());
+  {
+    TS_Property<std::vector<int>>::ReadScope batch(TS_PropVi3);
+    std::cout << "\n  in ReadScope, front = " << batch->front() << ", back = " << batch->back();
+  }
+
+  std::cout << "\n\n  Testing range operations on TS_Property<std::vector<int>>";
+  std::cout << "\n -----------------------------------------------------------";
+  TS_Property<std::vector<int>> TS_PropVi4;
+  TS_PropVi4.reserve(16);
+  TS_PropVi4.append({ 1, 2, 3 });
+  std::vector<int> batch{ 4, 5, 6 };
+  TS_PropVi4.append(batch.begin(), batch.end());
+  TS_PropVi4.append(std::vector<int>{ 7, 8 });
+  show("after append({1,2,3}), append(batch), append(std::vector<int>{7,8}):", TS_PropVi4());
+  TS_PropVi4.insert(TS_PropVi4.begin(), { -2, -1 });
+  show("after insert(begin(), { -2, -1 }):", TS_PropVi4());
+  iter = TS_PropVi4.begin();
+  TS_PropVi4.erase(iter + 2, iter + 5);
+  show("after erase(begin() + 2, begin() + 5):", TS_PropVi4());
+  TS_PropVi4.resize(3);
+  TS_PropVi4.shrink_to_fit();
+  show("after resize(3), shrink_to_fit():", TS_PropVi4());
+  TS_PropVi4.assign({ 9, 9 });
+  show("after assign({ 9, 9 }):", TS_PropVi4());
+  TS_Property<std::deque<double>> TS_PropDd2;
+  TS_PropDd2.append({ 1.5, 2.5 });
+  show("TS_PropDd2 after append({ 1.5, 2.5 }):", TS_PropDd2());
+
+  std::cout << "\n\n  Testing ShardedProperty<std::unordered_map<int, int>, 8>";
+  std::cout << "\n ----------------------------------------------------------";
+  ShardedProperty<std::unordered_map<int, int>, 8> SH_UnordMap1;
+  std::cout << "\n  four threads each inserting 250 distinct keys";
+  std::vector<std::thread> inserters;
+  for (int i = 0; i < 4; ++i)
+  {
+    inserters.push_back(std::thread([&SH_UnordMap1, i]() {
+      for (int j = 0; j < 250; ++j)
+        SH_UnordMap1.insert({ 250 * i + j, j });
+    }));
+  }
+  for (auto& inserter : inserters)
+    inserter.join();
+  std::cout << "\n  SH_UnordMap1.size() = " << SH_UnordMap1.size();
+  std::cout << "\n  SH_UnordMap1.contains(999) = " << std::boolalpha << SH_UnordMap1.contains(999);
+  std::cout << "\n  SH_UnordMap1.editItem(999, -1) = " << SH_UnordMap1.editItem(999, -1);
+  std::cout << "\n  SH_UnordMap1[999] = " << SH_UnordMap1[999];
+  std::cout << "\n  SH_UnordMap1.erase(999) = " << SH_UnordMap1.erase(999);
+  std::cout << "\n  SH_UnordMap1.find(999) has value: " << SH_UnordMap1.find(999).has_value();
+  long long keySum = 0;
+  SH_UnordMap1.for_each([&keySum](const std::pair<const int, int>& item) { keySum += item.first; });
+  std::cout << "\n  sum of keys from for_each = " << keySum;
+  std::cout << "\n  SH_UnordMap1().size() = " << SH_UnordMap1().size() << std::noboolalpha;
+
+  std::cout << "\n\n  Testing QueueProperty<int> with capacity 8";
+  std::cout << "\n --------------------------------------------";
+  QueueProperty<int> Q_iProp1(8);
+  std::vector<int> consumed(2, 0);
+  std::vector<std::thread> consumers;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    consumers.push_back(std::thread([&Q_iProp1, &consumed, i]() {
+      while (auto item = Q_iProp1.wait_pop())
+        consumed[i] += 1;
+    }));
+  }
+  std::vector<int> jobs(100, 1);
+  std::cout << "\n  producer pushed " << Q_iProp1.push_n(jobs.begin(), jobs.end()) << " items";
+  for (int i = 0; i < 20; ++i)
+    Q_iProp1.push(i);
+  Q_iProp1.close();
+  for (auto& consumer : consumers)
+    consumer.join();
+  std::cout << "\n  consumers popped " << consumed[0] + consumed[1] << " items";
+  std::cout << "\n  try_push after close() returned " << std::boolalpha << Q_iProp1.try_push(1);
+
+  QueueProperty<int> Q_iProp2;
+  Q_iProp2.push(1);
+  Q_iProp2.push(2);
+  Q_iProp2.push(3);
+  std::vector<int> drained = Q_iProp2.pop_n(2);
+  show("Q_iProp2.pop_n(2) returned", drained);
+  std::cout << "\n  Q_iProp2.try_pop() returned " << *Q_iProp2.try_pop();
+  std::cout << "\n  Q_iProp2.wait_pop_for(10ms) has value: "
+    << Q_iProp2.wait_pop_for(std::chrono::milliseconds(10)).has_value() << std::noboolalpha;
+
+  std::cout << "\n\n  Testing SPSC_RingProperty<int, 64> and MPMC_RingProperty<int, 64>";
+  std::cout << "\n --------------------------------------------------------------------";
+  SPSC_RingProperty<int, 64> SPSC_iRing;
+  long long spscSum = 0;
+  std::thread spscConsumer([&SPSC_iRing, &spscSum]() {
+    int received = 0;
+    int buffer[16];
+    while (received < 10000)
+    {
+      size_t n = SPSC_iRing.try_pop_n(buffer, 16);
+      for (size_t i = 0; i < n; ++i)
+        spscSum += buffer[i];
+      received += static_cast<int>(n);
+      if (n == 0)
+        std::this_thread::yield();
+    }
+  });
+  for (int i = 0; i < 10000; ++i)
+  {
+    while (!SPSC_iRing.try_push(i))
+      std::this_thread::yield();
+  }
+  spscConsumer.join();
+  std::cout << "\n  SPSC consumer summed 0..9999 = " << spscSum;
+
+  MPMC_RingProperty<int, 64> MPMC_iRing;
+  std::atomic<long long> mpmcSum = 0;
+  std::atomic<int> mpmcReceived = 0;
+  std::vector<std::thread> ringThreads;
+  for (int p = 0; p < 2; ++p)
+  {
+    ringThreads.push_back(std::thread([&MPMC_iRing, p]() {
+      for (int i = 0; i < 5000; ++i)
+      {
+        while (!MPMC_iRing.try_push(5000 * p + i))
+          std::this_thread::yield();
+      }
+    }));
+  }
+  for (int c = 0; c < 2; ++c)
+  {
+    ringThreads.push_back(std::thread([&MPMC_iRing, &mpmcSum, &mpmcReceived]() {
+      int item;
+      while (mpmcReceived < 10000)
+      {
+        if (MPMC_iRing.try_pop(item))
+        {
+          mpmcSum += item;
+          ++mpmcReceived;
+        }
+        else
+          std::this_thread::yield();
+      }
+    }));
+  }
+  for (auto& ringThread : ringThreads)
+    ringThread.join();
+  std::cout << "\n  two MPMC consumers summed 0..9999 = " << mpmcSum;
+
+  std::cout << "\n\n  Testing change notifications on TS_Property<int>";
+  std::cout << "\n --------------------------------------------------";
+  TS_Property<int> TS_iProp4;
+  std::mutex seenMtx;
+  std::condition_variable seenCv;
+  int lastSeen = 0;
+  size_t calls = 0;
+  size_t subId = TS_iProp4.subscribe([&](const int& value) {
+    std::lock_guard<std::mutex> lck(seenMtx);
+    lastSeen = value;
+    ++calls;
+    seenCv.notify_one();
+  });
+  std::cout << "\n  subscribed, then wrote 1 through 100";
+  for (int i = 1; i <= 100; ++i)
+    TS_iProp4 = i;
+  {
+    std::unique_lock<std::mutex> lck(seenMtx);
+    seenCv.wait(lck, [&]() { return lastSeen == 100; });
+  }
+  std::cout << "\n  subscriber saw latest value " << lastSeen << " after " << calls << " call(s)";
+  std::cout << "\n  unsubscribe(" << subId << ") returned " << std::boolalpha << TS_iProp4.unsubscribe(subId);
+  std::cout << std::noboolalpha;
+
+  std::cout << "\n\n  Testing lock telemetry on TS_Property<std::vector<int>>";
+  std::cout << "\n ---------------------------------------------------------";
+  TS_Property<std::vector<int>> TS_PropVi5;
+  TS_PropVi5.telemetryName("TS_PropVi5");
+  std::vector<std::thread> pushers;
+  for (int i = 0; i < 2; ++i)
+  {
+    pushers.push_back(std::thread([&TS_PropVi5]() {
+      for (int j = 0; j < 1000; ++j)
+        TS_PropVi5.push_back(j);
+    }));
+  }
+  for (auto& pusher : pushers)
+    pusher.join();
+  std::cout << "\n  TS_PropVi5.size() = " << TS_PropVi5.size();
+#ifdef PROPERTY_TELEMETRY
+  TelemetryRegistry::instance().dumpText(std::cout);
+  std::cout << "\n";
+  TelemetryRegistry::instance().dumpJson(std::cout);
+#else
+  std::cout << "\n  define PROPERTY_TELEMETRY to collect and dump lock statistics";
+#endif
+
+  std::cout << "\n\n  Testing tracing of PropertyBase<int> operations";
+  std::cout << "\n -------------------------------------------------";
+  PropertyBase<int> iProp4 = 4;
+  iProp4 = iProp4() + 1;
+  std::cout << "\n  iProp4 = " << iProp4();
+#ifdef PROPERTY_TRACE
+  PropertyTrace::TraceSink::instance().flush();
+#else
+  std::cout << "\n  define PROPERTY_TRACE to record property operations";
+#endif
+
+  std::cout << "\n\n  Testing move, swap, take, and emplace on Property<std::vector<std::string>>";
+  std::cout << "\n ------------------------------------------------------------------------------";
+  std::vector<std::string> bigVec(1000000, "move me");
+  bigVec.reserve(bigVec.size() + 2);  // room for the two items added below
+  const std::string* pData = bigVec.data();
+  Property<std::vector<std::string>> PropVs = std::move(bigVec);
+  PropVs.emplace_back(3, 'x');
+  PropVs.push_back(std::string("moved in"));
+  std::vector<std::string> other{ "other" };
+  PropVs.swap(other);
+  std::cout << "\n  swap returned the moved-in buffer: " << std::boolalpha << (other.data() == pData);
+  PropVs = std::move(other);
+  std::vector<std::string> taken = PropVs.take();
+  std::cout << "\n  take returned the same buffer: " << (taken.data() == pData) << std::noboolalpha;
+  std::cout << "\n  taken.size() = " << taken.size() << ", last two items: "
+    << taken[taken.size() - 2] << ", " << taken.back();
+  std::cout << "\n  PropVs.size() after take = " << PropVs.size();
+
+  TS_Property<std::map<int, std::string>> TS_PropMis;
+  TS_PropMis.emplace(1, "one");
+  std::string two = "two";
+  TS_PropMis.try_emplace(2, std::move(two));
+  std::string again = "again";
+  auto tried = TS_PropMis.try_emplace(2, std::move(again));
+  std::cout << "\n  try_emplace on existing key inserted: " << std::boolalpha << tried.second
+    << ", argument left intact: \"" << again << "\"" << std::noboolalpha;
+  show("TS_PropMis = ", TS_PropMis());
+
+  std::cout << "\n\n  Testing footprint of thread-safe properties";
+  std::cout << "\n ---------------------------------------------";
+  std::cout << "\n  sizeof              int  std::string  std::vector<int>";
+  std::cout << "\n  TS_Property      " << std::setw(6) << sizeof(TS_Property<int>)
+    << std::setw(13) << sizeof(TS_Property<std::string>) << std::setw(18) << sizeof(TS_Property<std::vector<int>>);
+  std::cout << "\n  RW_Property      " << std::setw(6) << sizeof(RW_Property<int>)
+    << std::setw(13) << sizeof(RW_Property<std::string>) << std::setw(18) << sizeof(RW_Property<std::vector<int>>);
+  std::cout << "\n  Compact_Property " << std::setw(6) << sizeof(Compact_Property<int>)
+    << std::setw(13) << sizeof(Compact_Property<std::string>) << std::setw(18) << sizeof(Compact_Property<std::vector<int>>);
+  std::vector<Compact_Property<int>> counters(4);
+  std::vector<std::thread> counterThreads;
+  for (int i = 0; i < 4; ++i)
+  {
+    counterThreads.push_back(std::thread([&counters]() {
+      for (int j = 0; j < 10000; ++j)
+        counters[j % 4].modify([](int& count) { ++count; });
+    }));
+  }
+  for (auto& counterThread : counterThreads)
+    counterThread.join();
+  std::cout << "\n  four threads incremented four Compact_Property<int> counters: "
+    << counters[0]() << " " << counters[1]() << " " << counters[2]() << " " << counters[3]();
+
+  std::cout << "\n\n  Testing per-worker counters in Aligned_Property<std::int64_t>";
+  std::cout << "\n ---------------------------------------------------------------";
+  std::cout << "\n  sizeof(TS_Property<std::int64_t>) = " << sizeof(TS_Property<std::int64_t>)
+    << ", sizeof(Aligned_Property<std::int64_t>) = " << sizeof(Aligned_Property<std::int64_t>)
+    << ", alignof = " << alignof(Aligned_Property<std::int64_t>);
+  std::vector<Aligned_Property<std::int64_t>> workerCounts(4);
+  bool ownLines = true;
+  for (auto& count : workerCounts)
+    ownLines = ownLines && reinterpret_cast<std::uintptr_t>(&count) % 64 == 0;
+  std::cout << "\n  each counter starts its own cache line: " << std::boolalpha << ownLines << std::noboolalpha;
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < workerCounts.size(); ++i)
+  {
+    workers.push_back(std::thread([&workerCounts, i]() {
+      for (int j = 0; j < 10000; ++j)
+        workerCounts[i].modify([](std::int64_t& count) { ++count; });
+    }));
+  }
+  for (auto& worker : workers)
+    worker.join();
+  std::cout << "\n  worker counts:";
+  for (auto& count : workerCounts)
+    std::cout << " " << count();
+
+  std::cout << "\n\n  Testing PropertyTable<std::string, double, int>";
+  std::cout << "\n -------------------------------------------------";
+  enum { Name, Balance, Visits };
+  PropertyTable<std::string, double, int> accounts;
+  accounts.reserve(1000);
+  for (int i = 0; i < 1000; ++i)
+    accounts.addRow("account" + std::to_string(i), 10.0 * i, i % 7);
+  auto balance = accounts.at<Balance>(42);
+  balance = balance() + 0.5;
+  accounts.at<Name>(42) = "renamed";
+  std::cout << "\n  row 42: " << accounts.at<Name>(42)() << ", balance " << balance();
+  accounts.for_each<Visits>([](int& visits) { ++visits; });
+  double totalBalance = accounts.reduce<Balance>(0.0, [](double acc, double b) { return acc + b; });
+  size_t busy = accounts.count_if<Visits>([](int visits) { return visits > 5; });
+  size_t found = accounts.find_if<Balance>([](double b) { return b > 5000.0; });
+  std::cout << "\n  total balance = " << totalBalance << ", rows with visits > 5 = " << busy
+    << ", first balance over 5000 in row " << found;
+
+  std::cout << "\n\n  Testing numeric operations on TS_Property<std::vector<float>>";
+  std::cout << "\n ---------------------------------------------------------------";
+  std::cout << "\n  kernels in use: " << PropertyNumerics::simdPath();
+  std::vector<float> samples(1000003);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<float>(i % 1000) - 500.0f;
+  TS_Property<std::vector<float>> TS_PropVf(std::move(samples));
+  std::vector<float> copied = TS_PropVf();  // copy out and loop, for comparison
+  double copiedSum = 0.0;
+  for (float f : copied)
+    copiedSum += f;
+  std::cout << "\n  sum = " << PropertyNumerics::sum(TS_PropVf) << ", copy and loop sum = " << copiedSum;
+  std::cout << "\n  min = " << PropertyNumerics::minimum(TS_PropVf) << ", max = " << PropertyNumerics::maximum(TS_PropVf);
+  std::vector<float> ones(copied.size(), 1.0f);
+  std::cout << "\n  dot with ones = " << PropertyNumerics::dot(TS_PropVf, ones);
+  PropertyNumerics::scale(TS_PropVf, 0.5f);
+  PropertyNumerics::clamp(TS_PropVf, -100.0f, 100.0f);
+  std::cout << "\n  after scale(0.5) and clamp(-100, 100): min = " << PropertyNumerics::minimum(TS_PropVf)
+    << ", max = " << PropertyNumerics::maximum(TS_PropVf);
+  Property<std::vector<int>> PropVi9(std::vector<int>{ 2000000000, 2000000000, 3, -4, 5, 6, 7, 8, 9 });
+  std::cout << "\n  Property<std::vector<int>> sum, without 32 bit overflow = " << PropertyNumerics::sum(PropVi9);
+
+  std::cout << "\n\n  Testing parallel algorithms on TS_Property<std::vector<int>>";
+  std::cout << "\n --------------------------------------------------------------";
+  std::cout << "\n  worker pool concurrency = " << PropertyParallel::WorkerPool::instance().concurrency();
+  std::vector<int> unsorted(2000000);
+  for (size_t i = 0; i < unsorted.size(); ++i)
+    unsorted[i] = static_cast<int>((i * 2654435761u) % 1000003);
+  TS_Property<std::vector<int>> TS_PropVi10(std::move(unsorted));
+  PropertyParallel::sort(TS_PropVi10);
+  bool isSorted = TS_PropVi10.read([](const std::vector<int>& v) { return std::is_sorted(v.begin(), v.end()); });
+  std::cout << "\n  sorted " << TS_PropVi10.size() << " elements: " << std::boolalpha << isSorted << std::noboolalpha;
+  PropertyParallel::transform(TS_PropVi10, [](int i) { return i % 10; });
+  PropertyParallel::for_each(TS_PropVi10, [](int& i) { i += 1; });
+  long long digitSum = PropertyParallel::reduce(TS_PropVi10, 0LL, [](long long acc, long long i) { return acc + i; });
+  size_t tens = PropertyParallel::count_if(TS_PropVi10, [](int i) { return i == 10; });
+  std::cout << "\n  after transform and for_each: sum = " << digitSum << ", count of 10s = " << tens;
+
+  std::cout << "\n\n  Testing version() polling on RW_Property<std::vector<int>>";
+  std::cout << "\n ------------------------------------------------------------";
+  RW_Property<std::vector<int>> RW_PropVi11(std::vector<int>(10000, 1));
+  std::vector<int> cached;
+  std::uint64_t cachedVersion = 0;
+  size_t copies = 0;
+  for (int poll = 0; poll < 1000; ++poll)
+  {
+    if (poll % 100 == 0)
+      RW_PropVi11.push_back(poll);
+    std::uint64_t current = RW_PropVi11.version();
+    if (current != cachedVersion)
+    {
+      cached = RW_PropVi11();
+      cachedVersion = current;
+      ++copies;
+    }
+  }
+  std::cout << "\n  1000 polls, 10 writes: copied the value " << copies << " times, cached size = " << cached.size();
+  SeqLockProperty<Position> seqPos;
+  seqPos = Position{ 1.0, 2.0, 3.0 };
+  SnapshotProperty<std::vector<int>> snapVi;
+  snapVi.modify([](std::vector<int>& v) { v.push_back(1); });
+  std::cout << "\n  SeqLockProperty version = " << seqPos.version() << ", SnapshotProperty version = " << snapVi.version();
+
+  std::cout << "\n\n  Testing ComputedProperty<double, TS_Property<std::vector<double>>, RW_Property<double>>";
+  std::cout << "\n -----------------------------------------------------------------------------------------";
+  TS_Property<std::vector<double>> TS_orders(std::vector<double>{ 10.0, 20.0, 30.0 });
+  RW_Property<double> RW_taxRate(0.5);
+  ComputedProperty<double, TS_Property<std::vector<double>>, RW_Property<double>> orderTotal(
+    [](TS_Property<std::vector<double>>& orders, RW_Property<double>& taxRate) {
+      double rate = taxRate();
+      return orders.read([rate](const std::vector<double>& v) {
+        double total = 0.0;
+        for (double d : v)
+          total += d;
+        return total * (1.0 + rate);
+      });
+    },
+    TS_orders, RW_taxRate
+  );
+  std::cout << "\n  orderTotal = " << orderTotal() << ", read again = " << orderTotal()
+    << ", computed " << orderTotal.computeCount() << " time(s)";
+  TS_orders.push_back(40.0);
+  std::vector<std::thread> totalReaders;
+  for (int i = 0; i < 4; ++i)
+    totalReaders.push_back(std::thread([&orderTotal]() { orderTotal(); }));
+  for (auto& reader : totalReaders)
+    reader.join();
+  std::cout << "\n  after push_back(40), four concurrent readers: orderTotal = " << orderTotal()
+    << ", computed " << orderTotal.computeCount() << " time(s)";
+  ComputedProperty<std::string, decltype(orderTotal)> totalLabel(
+    [](decltype(orderTotal)& total) { return "total: " + std::to_string(total()); },
+    orderTotal
+  );
+  RW_taxRate = 0.0;
+  std::cout << "\n  chained, after tax rate set to 0: " << totalLabel();
+
+  std::cout << "\n\n  Testing BindingEngine with a fan-out of 1000 bound properties";
+  std::cout << "\n ---------------------------------------------------------------";
+  TS_Property<int> TS_price(10);
+  TS_Property<int> TS_quantity(2);
+  Property<int> subtotal;
+  std::vector<std::unique_ptr<Property<int>>> shares;
+  Property<int> glitches;
+  {
+    PropertyBinding::BindingEngine engine;
+    engine.bind(subtotal, [](const int& price, const int& quantity) { return price * quantity; }, TS_price, TS_quantity);
+    for (int i = 0; i < 1000; ++i)
+    {
+      shares.push_back(std::make_unique<Property<int>>());
+      engine.bind(*shares.back(), [i](const int& sub) { return sub + i; }, subtotal);
+    }
+    int glitchCount = 0;
+    engine.bind(glitches, [&glitchCount](const int& sub, const int& first, const int& last) {
+      if (first != sub || last != sub + 999)  // inputs from different waves
+        ++glitchCount;
+      return glitchCount;
+    }, subtotal, *shares.front(), *shares.back());
+    std::cout << "\n  " << engine.nodeCount() << " nodes, subtotal = " << subtotal() << ", shares[999] = " << (*shares[999])();
+    std::uint64_t wavesBefore = engine.waveCount();
+    engine.batch([&]() {
+      TS_price = 20;
+      TS_quantity = 3;
+    });
+    engine.settle();
+    std::cout << "\n  after batched writes: subtotal = " << subtotal() << ", shares[999] = " << (*shares[999])()
+      << ", waves = " << engine.waveCount() - wavesBefore << ", glitches = " << glitches();
+  }
+
+  std::cout << "\n\n  Testing PropertyGroup snapshot and restore";
+  std::cout << "\n --------------------------------------------";
+  TS_Property<std::vector<double>> TS_readings(std::vector<double>(100000, 2.5));
+  TS_Property<std::deque<std::string>> TS_names(std::deque<std::string>{ "alpha", "beta", "gamma" });
+  TS_Property<std::unordered_map<std::string, std::vector<int>>> TS_index;
+  TS_index.insert({ "evens", { 0, 2, 4 } });
+  TS_index.insert({ "odds", { 1, 3, 5 } });
+  Property<std::list<int>> listProp;
+  listProp.push_back(1);
+  listProp.push_back(2);
+  PropertySnapshot::PropertyGroup saveGroup;
+  saveGroup.add("readings", TS_readings);
+  saveGroup.add("names", TS_names);
+  saveGroup.add("index", TS_index);
+  saveGroup.add("list", listProp);
+  std::stringstream snapshotStream(std::ios::in | std::ios::out | std::ios::binary);
+  saveGroup.save(snapshotStream);
+  std::cout << "\n  snapshot of four properties = " << snapshotStream.str().size() << " bytes";
+
+  TS_Property<std::vector<double>> TS_readings2;
+  TS_Property<std::deque<std::string>> TS_names2;
+  TS_Property<std::unordered_map<std::string, std::vector<int>>> TS_index2;
+  PropertySnapshot::PropertyGroup loadGroup;
+  loadGroup.add("readings", TS_readings2);
+  loadGroup.add("names", TS_names2);
+  loadGroup.add("index", TS_index2);
+  size_t restored = loadGroup.load(snapshotStream);
+  std::cout << "\n  restored " << restored << " properties, skipped the unregistered list";
+  std::cout << "\n  readings equal: " << std::boolalpha << (TS_readings2() == TS_readings())
+    << ", names equal: " << (TS_names2() == TS_names())
+    << ", index equal: " << (TS_index2() == TS_index()) << std::noboolalpha;
+  show("names restored = ", TS_names2());
+
+  std::cout << "\n\n  Testing PropertyJournal recovery with group commit";
+  std::cout << "\n ----------------------------------------------------";
+#ifdef PROPERTY_JOURNAL
+  {
+    std::string journalPath = (std::filesystem::temp_directory_path() / "PropertyJournalDemo").string();
+    std::vector<int> expectedOrders;
+    std::map<std::string, int> expectedStock;
+    {
+      PropertyJournal::Journal journal(journalPath);
+      TS_Property<std::vector<int>> orders;
+      TS_Property<std::map<std::string, int>> stock;
+      journal.attach(1, orders);
+      journal.attach(2, stock);
+      journal.recover();
+      orders = std::vector<int>();
+      stock = std::map<std::string, int>();
+      journal.checkpoint();
+
+      std::vector<std::thread> clerks;
+      for (int i = 0; i < 4; ++i)
+      {
+        clerks.push_back(std::thread([&orders, &journal, i]() {
+          for (int j = 0; j < 250; ++j)
+          {
+            orders.push_back(i * 1000 + j);
+            journal.sync();
+          }
+        }));
+      }
+      for (auto& clerk : clerks)
+        clerk.join();
+      stock.editItem("bolts", 40);
+      stock.editItem("nuts", 75);
+      stock.editItem("bolts", 38);
+      orders.erase(orders.begin(), orders.begin() + 10);
+      journal.sync();
+      std::cout << "\n  " << journal.records() << " records made durable by " << journal.syncs() << " syncs";
+      expectedOrders = orders();
+      expectedStock = stock();
+    }
+
+    PropertyJournal::Journal journal(journalPath);
+    TS_Property<std::vector<int>> orders;
+    TS_Property<std::map<std::string, int>> stock;
+    journal.attach(1, orders);
+    journal.attach(2, stock);
+    size_t replayed = journal.recover();
+    std::cout << "\n  replayed " << replayed << " records after restart";
+    std::cout << "\n  orders equal: " << std::boolalpha << (orders() == expectedOrders)
+      << ", stock equal: " << (stock() == expectedStock) << std::noboolalpha;
+    show("stock = ", stock());
+  }
+#else
+  std::cout << "\n  define PROPERTY_JOURNAL to journal property mutations";
+#endif
+
+  std::cout << "\n\n  Testing MappedVectorProperty reopened from its file";
+  std::cout << "\n ----------------------------------------------------";
+  {
+    struct Tick { std::int64_t time; double price; };
+    std::string tickPath = (std::filesystem::temp_directory_path() / "MappedVectorDemo.dat").string();
+    std::filesystem::remove(tickPath);
+    {
+      MappedVectorProperty<Tick> ticks(tickPath);
+      for (std::int64_t i = 0; i < 1000000; ++i)
+        ticks.push_back(Tick{ i, 100.0 + static_cast<double>(i % 100) / 100.0 });
+      ticks.flush();
+      std::cout << "\n  wrote " << ticks.size() << " ticks";
+    }
+    {
+      auto start = std::chrono::steady_clock::now();
+      MappedVectorProperty<Tick> ticks(tickPath);
+      auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start
+      );
+      Tick last = ticks[static_cast<int>(ticks.size()) - 1];
+      std::cout << "\n  reopened " << ticks.size() << " ticks in " << elapsed.count() << " microseconds";
+      std::cout << "\n  last tick: time = " << last.time << ", price = " << last.price;
+    }
+    std::filesystem::remove(tickPath);
+  }
+
+  std::cout << "\n\n  Timing reads of RW_Property and TS_Property<std::vector<int>>";
+  std::cout << "\n ---------------------------------------------------------------";
+  std::cout << "\n  hardware threads: " << std::thread::hardware_concurrency() << ", 200000 reads of [i] per thread";
+  {
+    RW_Property<std::vector<int>> rwReads(std::vector<int>(1024, 1));
+    TS_Property<std::vector<int>> tsReads(std::vector<int>(1024, 1));
+    const RW_Property<std::vector<int>>& rw = rwReads;  // const operator[] locks
+    const TS_Property<std::vector<int>>& ts = tsReads;
+    for (size_t threads : threadCounts())
+    {
+      std::string count = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+      showRate("RW_Property reads, " + count, opsPerSecOn(threads, 200000,
+        [&](size_t, size_t i) { return rw[static_cast<int>(i % 1024)]; }));
+      showRate("TS_Property reads, " + count, opsPerSecOn(threads, 200000,
+        [&](size_t, size_t i) { return ts[static_cast<int>(i % 1024)]; }));
+    }
+  }
+
+  std::cout << "\n\n  Timing AtomicProperty<long long> against TS_Property<long long>";
+  std::cout << "\n -----------------------------------------------------------------";
+  std::cout << "\n  200000 increments, then 200000 reads, per thread, on one shared counter";
+  {
+    AtomicProperty<long long> atomicCount(0);
+    TS_Property<long long> lockedCount(0);
+    for (size_t threads : threadCounts())
+    {
+      std::string count = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+      showRate("AtomicProperty fetch_add, " + count, opsPerSecOn(threads, 200000,
+        [&](size_t, size_t) { atomicCount.fetch_add(1); }));
+      showRate("TS_Property modify(++), " + count, opsPerSecOn(threads, 200000,
+        [&](size_t, size_t) { lockedCount.modify([](long long& n) { ++n; }); }));
+      showRate("AtomicProperty load, " + count, opsPerSecOn(threads, 200000,
+        [&](size_t, size_t) { return atomicCount.load(); }));
+      showRate("TS_Property operator(), " + count, opsPerSecOn(threads, 200000,
+        [&](size_t, size_t) { return lockedCount(); }));
+    }
+    std::cout << "\n  counts agree: " << std::boolalpha << (atomicCount() == lockedCount()) << std::noboolalpha;
+  }
+
+  std::cout << "\n\n  Timing SeqLockProperty<Quote> against TS_Property<Quote>, one writer";
+  std::cout << "\n ----------------------------------------------------------------------";
+  std::cout << "\n  200000 reads per reader thread while one thread writes continuously";
+  {
+    struct Quote { double bid, ask, last; long long time; };
+    SeqLockProperty<Quote> seqQuote(Quote{ 0.0, 0.0, 0.0, 0 });
+    TS_Property<Quote> lockedQuote(Quote{ 0.0, 0.0, 0.0, 0 });
+
+    //----< time readers, return writer's median and 99th percentile ns >--
+    auto timeOneWriter = [](size_t readers, auto read, auto write, double& readRate) {
+      std::atomic<bool> stop { false };
+      std::vector<double> latencies;
+      latencies.reserve(1 << 20);
+      std::thread writer([&]() {
+        for (long long i = 0; !stop.load(); ++i)
+        {
+          BenchClock::time_point start = BenchClock::now();
+          write(Quote{ 1.0 * i, 1.0 * i + 0.5, 1.0 * i + 0.25, i });
+          double ns = 1e9 * secondsSince(start);
+          if (latencies.size() < latencies.capacity())
+            latencies.push_back(ns);
+        }
+      });
+      readRate = opsPerSecOn(readers, 200000, [&](size_t, size_t) { return read().time; });
+      stop.store(true);
+      writer.join();
+      std::sort(latencies.begin(), latencies.end());
+      if (latencies.empty())
+        return std::make_pair(0.0, 0.0);
+      return std::make_pair(latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+    };
+    for (size_t readers : threadCounts())
+    {
+      std::string count = std::to_string(readers) + (readers == 1 ? " reader" : " readers");
+      double readRate = 0.0;
+      auto seqWrite = timeOneWriter(readers, [&]() { return seqQuote.load(); },
+        [&](const Quote& q) { seqQuote.store(q); }, readRate);
+      showRate("SeqLockProperty reads, " + count, readRate);
+      auto lockedWrite = timeOneWriter(readers, [&]() { return lockedQuote(); },
+        [&](const Quote& q) { lockedQuote = q; }, readRate);
+      showRate("TS_Property reads, " + count, readRate);
+      std::cout << "\n  writer latency ns, median / 99th percentile:  SeqLockProperty "
+        << seqWrite.first << " / " << seqWrite.second << ",  TS_Property "
+        << lockedWrite.first << " / " << lockedWrite.second;
+    }
+  }
+
+  std::cout << "\n\n  Timing batched and per-operation locking on TS_Property<std::vector<int>>";
+  std::cout << "\n ---------------------------------------------------------------------------";
+  std::cout << "\n  100 rounds of 10000 push_backs, rate is push_backs per second";
+  {
+    TS_Property<std::vector<int>> pushed;
+    auto perPush = [&](size_t) {
+      pushed.take();
+      for (int i = 0; i < 10000; ++i)
+        pushed.push_back(i);
+    };
+    auto modified = [&](size_t) {
+      pushed.take();
+      pushed.modify([](std::vector<int>& v) {
+        for (int i = 0; i < 10000; ++i)
+          v.push_back(i);
+      });
+    };
+    auto scoped = [&](size_t) {
+      pushed.take();
+      TS_Property<std::vector<int>>::WriteScope batch(pushed);
+      for (int i = 0; i < 10000; ++i)
+        batch->push_back(i);
+      batch.commit();
+    };
+    showRate("push_back, locking each", 10000 * opsPerSec(100, perPush));
+    showRate("modify(f), locking once", 10000 * opsPerSec(100, modified));
+    showRate("WriteScope, locking once", 10000 * opsPerSec(100, scoped));
+    std::cout << "\n  last round left " << pushed.size() << " items";
+  }
+
+  std::cout << "\n\n  Timing ShardedProperty<std::unordered_map<int, int>, 16> against TS_Property";
+  std::cout << "\n -----------------------------------------------------------------------------";
+  std::cout << "\n  100000 operations per thread, alternating insert and contains";
+  {
+    auto key = [](size_t thread, size_t i) { return static_cast<int>((thread * 100000 + i) * 2654435761u % 1000003); };
+    for (size_t threads : threadCounts())
+    {
+      std::string count = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+      ShardedProperty<std::unordered_map<int, int>, 16> shardedMap;
+      TS_Property<std::unordered_map<int, int>> lockedMap;
+      showRate("ShardedProperty, " + count, opsPerSecOn(threads, 100000, [&](size_t t, size_t i) {
+        return (i % 2 == 0) ? shardedMap.insert({ key(t, i), 1 }) : shardedMap.contains(key(t, i - 1));
+      }));
+      showRate("TS_Property, " + count, opsPerSecOn(threads, 100000, [&](size_t t, size_t i) {
+        return (i % 2 == 0) ? lockedMap.insert({ key(t, i), 1 }).second : lockedMap.contains(key(t, i - 1));
+      }));
+    }
+  }
+
+  std::cout << "\n\n  Timing ring buffer handoff against TS_Property<std::deque<long long>>";
+  std::cout << "\n ----------------------------------------------------------------------";
+  std::cout << "\n  one producer hands 200000 timestamps to one consumer; latency is push to pop";
+  {
+    //----< run the handoff, print throughput and latency percentiles >--
+    auto timeHandoff = [](const std::string& label, auto tryPush, auto tryPop) {
+      const size_t items = 200000;
+      std::vector<double> latencies(items);
+      BenchClock::time_point origin = BenchClock::now();
+      BenchClock::time_point start = BenchClock::now();
+      std::thread producer([&]() {
+        for (size_t i = 0; i < items; ++i)
+        {
+          long long stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - origin).count();
+          while (!tryPush(stamp))
+            std::this_thread::yield();
+        }
+      });
+      for (size_t i = 0; i < items; ++i)
+      {
+        long long stamp = 0;
+        while (!tryPop(stamp))
+          std::this_thread::yield();
+        long long now = std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - origin).count();
+        latencies[i] = static_cast<double>(now - stamp);
+      }
+      double seconds = secondsSince(start);
+      producer.join();
+      std::sort(latencies.begin(), latencies.end());
+      showRate(label, items / seconds);
+      std::cout << "\n    latency ns, median " << static_cast<long long>(latencies[items / 2])
+        << ", 99th percentile " << static_cast<long long>(latencies[items * 99 / 100]);
+    };
+    SPSC_RingProperty<long long, 1024> spscRing;
+    MPMC_RingProperty<long long, 1024> mpmcRing;
+    TS_Property<std::deque<long long>> lockedQueue;
+    timeHandoff("SPSC_RingProperty<long long, 1024>",
+      [&](long long v) { return spscRing.try_push(v); }, [&](long long& v) { return spscRing.try_pop(v); });
+    timeHandoff("MPMC_RingProperty<long long, 1024>",
+      [&](long long v) { return mpmcRing.try_push(v); }, [&](long long& v) { return mpmcRing.try_pop(v); });
+    timeHandoff("TS_Property<std::deque<long long>>",
+      [&](long long v) { lockedQueue.push_back(v); return true; },
+      [&](long long& v) {
+        return lockedQueue.modify([&v](std::deque<long long>& q) {
+          if (q.empty())
+            return false;
+          v = q.front();
+          q.pop_front();
+          return true;
+        });
+      });
+  }
+
+  std::cout << "\n\n  Timing Property<int> and TS_Property<std::vector<int>> operations";
+  std::cout << "\n -------------------------------------------------------------------";
+  std::cout << "\n  1000000 calls of each operation";
+  {
+    Property<int> plainInt(0);
+    Property<int>* volatile pPlainInt = &plainInt;  // reloaded each call, so calls aren't folded away
+    showRate("Property<int> assign", opsPerSec(1000000, [&](size_t i) { *pPlainInt = static_cast<int>(i); }));
+    showRate("Property<int> operator()", opsPerSec(1000000, [&](size_t) { return (*pPlainInt)(); }));
+    TS_Property<std::vector<int>> lockedInts;
+    lockedInts.reserve(1000000);
+    const TS_Property<std::vector<int>>& lockedView = lockedInts;
+    showRate("TS_Property<std::vector<int>> push_back", opsPerSec(1000000, [&](size_t i) { lockedInts.push_back(static_cast<int>(i)); }));
+    showRate("TS_Property<std::vector<int>> size", opsPerSec(1000000, [&](size_t) { return lockedInts.size(); }));
+    showRate("TS_Property<std::vector<int>> const operator[]", opsPerSec(1000000, [&](size_t i) { return lockedView[static_cast<int>(i)]; }));
+  }
+
+  std::cout << "\n\n  Timing construction and footprint of thread-safe properties";
+  std::cout << "\n -------------------------------------------------------------";
+  std::cout << "\n  constructing 100000 default properties in one std::vector";
+  {
+    //----< print size, allocations per property, and construction rate >--
+    auto timeConstruction = [](const std::string& label, auto* pType) {
+      using Prop = std::remove_pointer_t<decltype(pType)>;
+      const size_t count = 100000;
+      size_t before = allocations.load();
+      BenchClock::time_point start = BenchClock::now();
+      std::vector<Prop> props(count);
+      double seconds = secondsSince(start);
+      size_t allocated = allocations.load() - before - 1;  // less the vector's own buffer
+      showRate(label, count / seconds);
+      std::cout << "\n    sizeof = " << sizeof(Prop) << ", allocations per property = "
+        << static_cast<double>(allocated) / count;
+    };
+    timeConstruction("TS_Property<int>", static_cast<TS_Property<int>*>(nullptr));
+    timeConstruction("TS_Property<std::string>", static_cast<TS_Property<std::string>*>(nullptr));
+    timeConstruction("TS_Property<std::vector<int>>", static_cast<TS_Property<std::vector<int>>*>(nullptr));
+    timeConstruction("Compact_Property<int>", static_cast<Compact_Property<int>*>(nullptr));
+    timeConstruction("Compact_Property<std::string>", static_cast<Compact_Property<std::string>*>(nullptr));
+    timeConstruction("Compact_Property<std::vector<int>>", static_cast<Compact_Property<std::vector<int>>*>(nullptr));
+  }
+
+  std::cout << "\n\n  Timing packed and cache-line aligned per-thread counters";
+  std::cout << "\n ----------------------------------------------------------";
+  std::cout << "\n  each thread increments its own counter 200000 times, both counters use SpinLock";
+  {
+    for (size_t threads : threadCounts())
+    {
+      std::string count = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+      std::vector<Compact_Property<std::int64_t>> packed(threads);
+      std::vector<Aligned_Property<std::int64_t, SpinLock>> padded(threads);
+      showRate("packed Compact_Property, " + count, opsPerSecOn(threads, 200000,
+        [&](size_t t, size_t) { packed[t].modify([](std::int64_t& n) { ++n; }); }));
+      showRate("padded Aligned_Property, " + count, opsPerSecOn(threads, 200000,
+        [&](size_t t, size_t) { padded[t].modify([](std::int64_t& n) { ++n; }); }));
+    }
+    std::cout << "\n  sizeof packed = " << sizeof(Compact_Property<std::int64_t>)
+      << ", sizeof padded = " << sizeof(Aligned_Property<std::int64_t, SpinLock>);
+  }
+
+  std::cout << "\n\n  Timing numeric kernels against copying out and looping";
+  std::cout << "\n --------------------------------------------------------";
+  std::cout << "\n  50 passes over TS_Property<std::vector<float>> of 1000000 elements, rate is elements per second";
+  {
+    const size_t elements = 1000000;
+    std::vector<float> values(elements);
+    for (size_t i = 0; i < elements; ++i)
+      values[i] = static_cast<float>(i % 1000) * 0.001f;
+    TS_Property<std::vector<float>> numbers(std::move(values));
+    std::cout << "\n  kernels in use: " << PropertyNumerics::simdPath();
+    showRate("PropertyNumerics::sum", elements * opsPerSec(50, [&](size_t) {
+      return PropertyNumerics::sum(numbers);
+    }));
+    showRate("copy out, then loop summing", elements * opsPerSec(50, [&](size_t) {
+      std::vector<float> copy = numbers();
+      float total = 0.0f;
+      for (float f : copy)
+        total += f;
+      return total;
+    }));
+    showRate("PropertyNumerics::maximum", elements * opsPerSec(50, [&](size_t) {
+      return PropertyNumerics::maximum(numbers);
+    }));
+    showRate("copy out, then std::max_element", elements * opsPerSec(50, [&](size_t) {
+      std::vector<float> copy = numbers();
+      return *std::max_element(copy.begin(), copy.end());
+    }));
+    showRate("PropertyNumerics::scale", elements * opsPerSec(50, [&](size_t i) {
+      PropertyNumerics::scale(numbers, (i % 2 == 0) ? 2.0f : 0.5f);
+    }));
+    showRate("copy out, loop scaling, assign back", elements * opsPerSec(50, [&](size_t i) {
+      std::vector<float> copy = numbers();
+      for (float& f : copy)
+        f *= (i % 2 == 0) ? 2.0f : 0.5f;
+      numbers = std::move(copy);
+    }));
+  }
+
+  std::cout << "\n\n  Timing parallel sort and reduce against the standard algorithms";
+  std::cout << "\n -----------------------------------------------------------------";
+  std::cout << "\n  TS_Property<std::vector<int>> of 1000000 elements, rate is elements per second";
+  {
+    const size_t elements = 1000000;
+    std::vector<int> shuffled(elements);
+    unsigned state = 12345;
+    for (auto& i : shuffled)
+    {
+      state = state * 1103515245u + 12345u;
+      i = static_cast<int>(state >> 8);
+    }
+    TS_Property<std::vector<int>> ints;
+    PropertyParallel::WorkerPool& pool = PropertyParallel::WorkerPool::instance();
+    size_t defaultConcurrency = pool.concurrency();
+    std::cout << "\n  default worker pool concurrency = " << defaultConcurrency << ", each row sets it with setConcurrency";
+    for (size_t threads : threadCounts())
+    {
+      pool.setConcurrency(threads);
+      std::string count = std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+      showRate("assign, then PropertyParallel::sort, " + count, elements * opsPerSec(10, [&](size_t) {
+        ints = shuffled;
+        PropertyParallel::sort(ints);
+      }));
+      showRate("PropertyParallel::reduce, " + count, elements * opsPerSec(50, [&](size_t) {
+        return PropertyParallel::reduce(ints, 0LL, [](long long acc, long long i) { return acc + i; });
+      }));
+    }
+    showRate("copy, then std::sort", elements * opsPerSec(10, [&](size_t) {
+      std::vector<int> copy = shuffled;
+      std::sort(copy.begin(), copy.end());
+      return copy.front();
+    }));
+    pool.setConcurrency(defaultConcurrency);
+    showRate("read, then loop summing", elements * opsPerSec(50, [&](size_t) {
+      return ints.read([](const std::vector<int>& v) {
+        long long total = 0;
+        for (int i : v)
+          total += i;
+        return total;
+      });
+    }));
+  }
+
+  std::cout << "\n\n  Timing BindingEngine waves with a fan-out of 10000 bound properties";
+  std::cout << "\n ---------------------------------------------------------------------";
+  std::cout << "\n  200 writes to one root, each followed by settle()";
+  {
+    const size_t fanOut = 10000;
+    TS_Property<int> TS_base(0);
+    std::vector<std::unique_ptr<Property<int>>> targets;
+    PropertyBinding::BindingEngine engine;
+    for (size_t i = 0; i < fanOut; ++i)
+    {
+      targets.push_back(std::make_unique<Property<int>>());
+      int offset = static_cast<int>(i);
+      engine.bind(*targets.back(), [offset](const int& base) { return base + offset; }, TS_base);
+    }
+    engine.settle();
+    std::cout << "\n  " << engine.nodeCount() << " nodes, worker pool concurrency = "
+      << PropertyParallel::WorkerPool::instance().concurrency();
+    std::uint64_t wavesBefore = engine.waveCount();
+    double waves = opsPerSec(200, [&](size_t i) {
+      TS_base = static_cast<int>(i) + 1;
+      engine.settle();
+    });
+    std::ostringstream waveRate;
+    waveRate << std::fixed << std::setprecision(0) << std::setw(9) << waves << " waves/sec";
+    std::cout << "\n  " << std::left << std::setw(48) << "waves, write then settle" << std::right << waveRate.str();
+    showRate("bound properties evaluated", waves * fanOut);
+    std::cout << "\n  waves run = " << engine.waveCount() - wavesBefore
+      << ", last target = " << (*targets.back())();
+    showRate("same updates written by a loop, no engine", fanOut * opsPerSec(200, [&](size_t i) {
+      int base = static_cast<int>(i) + 1;
+      for (size_t t = 0; t < fanOut; ++t)
+        *targets[t] = base + static_cast<int>(t);
+    }));
+  }
+
+  std::cout << "\n\n  Timing PropertyGroup save and restore throughput";
+  std::cout << "\n --------------------------------------------------";
+  std::cout << "\n  20 saves and 20 restores of each property to a std::stringstream";
+  {
+    auto showBandwidth = [](const std::string& label, double bytesPerSec) {
+      std::ostringstream out;
+      out << std::fixed << std::setprecision(2) << std::setw(9) << bytesPerSec / 1e6 << " MB/sec";
+      std::cout << "\n  " << std::left << std::setw(48) << label << std::right << out.str();
+    };
+    auto timeGroup = [&](const std::string& name, auto& source, auto& target) {
+      PropertySnapshot::PropertyGroup saveOne;
+      saveOne.add(name, source);
+      PropertySnapshot::PropertyGroup loadOne;
+      loadOne.add(name, target);
+      std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+      double saves = opsPerSec(20, [&](size_t) {
+        stream.str("");
+        saveOne.save(stream);
+      });
+      std::string image = stream.str();
+      double loads = opsPerSec(20, [&](size_t) {
+        stream.clear();
+        stream.seekg(0);
+        return loadOne.load(stream);
+      });
+      std::cout << "\n  " << name << ": " << image.size() << " bytes, restored equal: "
+        << std::boolalpha << (target() == source()) << std::noboolalpha;
+      showBandwidth("  save " + name, saves * image.size());
+      showBandwidth("  restore " + name, loads * image.size());
+    };
+    TS_Property<std::vector<double>> TS_samples(std::vector<double>(1000000, 1.25));
+    TS_Property<std::vector<double>> TS_samples2;
+    timeGroup("vector<double>", TS_samples, TS_samples2);
+    std::deque<std::string> labels;
+    for (int i = 0; i < 100000; ++i)
+      labels.push_back("label " + std::to_string(i));
+    TS_Property<std::deque<std::string>> TS_labels(std::move(labels));
+    TS_Property<std::deque<std::string>> TS_labels2;
+    timeGroup("deque<string>", TS_labels, TS_labels2);
+    std::unordered_map<int, std::string> table;
+    for (int i = 0; i < 100000; ++i)
+      table[i] = "value " + std::to_string(i);
+    TS_Property<std::unordered_map<int, std::string>> TS_table(std::move(table));
+    TS_Property<std::unordered_map<int, std::string>> TS_table2;
+    timeGroup("unordered_map<int, string>", TS_table, TS_table2);
+  }
+
+  std::cout << "\n\n  Timing property mutations with journaling on and off";
+  std::cout << "\n ------------------------------------------------------";
+  std::cout << "\n  200000 push_backs on TS_Property<std::vector<int>>";
+  {
+    TS_Property<std::vector<int>> unjournaled;
+    showRate("push_back, not attached", opsPerSec(200000, [&](size_t i) {
+      unjournaled.push_back(static_cast<int>(i));
+    }));
+#ifdef PROPERTY_JOURNAL
+    std::filesystem::path benchDir = std::filesystem::temp_directory_path() / "PropertyJournalBench";
+    std::filesystem::remove_all(benchDir);
+    std::filesystem::create_directories(benchDir);
+    {
+      PropertyJournal::Journal journal((benchDir / "bench").string());
+      TS_Property<std::vector<int>> journaled;
+      journal.attach(1, journaled);
+      journal.recover();
+      showRate("push_back, attached, flushed in background", opsPerSec(200000, [&](size_t i) {
+        journaled.push_back(static_cast<int>(i));
+      }));
+      showRate("push_back, attached, sync every 1000", opsPerSec(200000, [&](size_t i) {
+        journaled.push_back(static_cast<int>(i));
+        if (i % 1000 == 999)
+          journal.sync();
+      }));
+      showRate("push_back, attached, sync every push_back", opsPerSec(2000, [&](size_t i) {
+        journaled.push_back(static_cast<int>(i));
+        journal.sync();
+      }));
+      std::cout << "\n  " << journal.records() << " records made durable by " << journal.syncs() << " syncs";
+    }
+    std::filesystem::remove_all(benchDir);
+#else
+    std::cout << "\n  define PROPERTY_JOURNAL to time attached properties; without it";
+    std::cout << "\n  mutators have no journal hook, so this rate is the unjournaled cost";
+#endif
+  }
+
+  std::cout << "\n\n  Timing MappedVectorProperty against TS_Property<std::vector>";
+  std::cout << "\n --------------------------------------------------------------";
+  std::cout << "\n  1000000 push_backs of a 16 byte tick, then 20 reopens of the file";
+  {
+    struct Tick { std::int64_t time; double price; };
+    const size_t ticks = 1000000;
+    std::string benchPath = (std::filesystem::temp_directory_path() / "MappedVectorBench.dat").string();
+    std::filesystem::remove(benchPath);
+    {
+      MappedVectorProperty<Tick> mapped(benchPath);
+      showRate("push_back, MappedVectorProperty", opsPerSec(ticks, [&](size_t i) {
+        mapped.push_back(Tick{ static_cast<std::int64_t>(i), 100.0 });
+      }));
+      auto start = BenchClock::now();
+      mapped.flush();
+      std::cout << "\n  flushed " << mapped.size() * sizeof(Tick) / 1000000 << " MB in "
+        << static_cast<long long>(secondsSince(start) * 1e3) << " milliseconds";
+    }
+    TS_Property<std::vector<Tick>> inMemory;
+    showRate("push_back, TS_Property<std::vector>", opsPerSec(ticks, [&](size_t i) {
+      inMemory.push_back(Tick{ static_cast<std::int64_t>(i), 100.0 });
+    }));
+    double reopens = opsPerSec(20, [&](size_t) {
+      MappedVectorProperty<Tick> reopened(benchPath);
+      return reopened.size();
+    });
+    std::cout << "\n  reopen, MappedVectorProperty: " << static_cast<long long>(1e6 / reopens)
+      << " microseconds each, " << static_cast<long long>(reopens * ticks / 1e6) << " M elements/sec";
+    {
+      MappedVectorProperty<Tick> reopened(benchPath);
+      showRate("elements read, reopened MappedVectorProperty", ticks * opsPerSec(20, [&](size_t) {
+        return reopened.read([](const MappedVector<Tick>& v) {
+          double total = 0.0;
+          for (size_t i = 0; i < v.size(); ++i)
+            total += v[i].price;
+          return total;
+        });
+      }));
+    }
+    showRate("elements read, TS_Property<std::vector>", ticks * opsPerSec(20, [&](size_t) {
+      return inMemory.read([](const std::vector<Tick>& v) {
+        double total = 0.0;
+        for (const Tick& tick : v)
+          total += tick.price;
+        return total;
+      });
+    }));
+    std::filesystem::remove(benchPath);
+  }
+
   std::cout << "\n\n  ---- That's all folks! ----";
   std::cout << "\n\n";
 }
\ No newline at end of file
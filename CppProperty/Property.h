@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // Property.h - Implements properties for C++                      //
-// ver 2.0 - 17 August 2019                                        //
+// ver 2.1 - 17 October 2026                                       //
 //-----------------------------------------------------------------//
 // Jim Fawcett (c) copyright 2019                                  //
 // All rights granted provided this copyright notice is retained   //
@@ -12,20 +12,47 @@
 * Package Operations:
 * -------------------
 * This Property package provides classes:
-* - PropContainer<T>
-*   Provides virtual methods get(), set(t), lock(), unlock() 
-* - PropertyBase<T>
+* - Lock policies NullLock, MutexLock, SharedMutexLock, SpinLock
+*   Provide lock(), unlock(), lock_shared(), unlock_shared().  The
+*   policy is a template parameter, so none of these are virtual
+*   and all property operations can be inlined.
+* - PropContainer<T, Lock>
+*   Provides methods get(), set(t), lock(), unlock(),
+*   lock_shared(), unlock_shared(), and WriteGuard, held by
+*   every mutator to lock, journal, and notify subscribers
+*   Define PROPERTY_TRACE to record its operations, see PropertyTrace.h
+*   Define PROPERTY_JOURNAL to journal its mutations, see PropertyJournal.h
+* - PropertyBase<T, Lock>
 *   Provides user methods:
-*     PropertyBase<T>& operator=(const T& t)
-*     void operator()(const T& t)
+*     PropertyBase& operator=(const T& t), operator=(T&& t)
+*     void operator()(const T& t), operator()(T&& t)
 *     T operator()()
-* - PropertyOps<T, Enabler=void>
-*     Intended for STL containers, e.g., PropertyOps<std::vector<int>>
-*     Provides a lot of the STL methods like push_back(const T& t)
+*     void swap(T& t), T take()
+*     uint64_t version(), without locking
+*     auto modify(F f), auto read(F f)
+*     size_t subscribe(callback), watch(callback), bool unsubscribe(id)
+*   and RAII scopes WriteScope and ReadScope, for running many
+*   operations on the value under one lock acquisition
+* - PropertyOps<T, Lock, Enabler=void>
+*     Intended for STL containers, e.g., PropertyOps<std::vector<int>, NullLock>
+*     Provides a lot of the STL methods like push_back(const T& t),
+*     emplace_back(args...), and range operations like append(first, last)
 * - PropertyOps<T, std::enable_if_t<std::is_arithmetic<T>::value>>
 *     A specialization for fundamental data, e.g., int, double, ...
+* - Property<T>
+*     PropertyOps<T, NullLock>, for use by a single thread
 * - TS_Property<T>
-*     A thread-safe version of PropertyOps<T>
+*     PropertyOps<T, MutexLock>, a thread-safe version
+*     Define PROPERTY_TELEMETRY to collect lock contention statistics
+* - RW_Property<T>
+*     PropertyOps<T, SharedMutexLock>, a thread-safe version using a
+*     reader-writer lock, so read-only operations run concurrently
+* - Compact_Property<T>
+*     PropertyOps<T, SpinLock>, a thread-safe version with a one byte
+*     lock, for programs holding very many small properties
+* - Aligned_Property<T, Lock, Align>
+*     PropertyOps<T, Lock> starting on its own cache line, so adjacent
+*     properties in an array don't falsely share
 *
 * Required Files:
 * ---------------
@@ -33,6 +60,40 @@
 *
 * Maintenance History:
 * --------------------
+* ver 2.1 : 17 Oct 2026
+* - added lock_shared() and unlock_shared(), used by read-only operations
+* - added RW_Property<T>
+* - TS_Property no longer holds its mutex after construction
+* - added modify(f), read(f), WriteScope, and ReadScope
+* - added range operations append, insert, erase, and assign, plus
+*   resize, reserve, and shrink_to_fit, for sequence containers
+* - added subscribe(callback) and unsubscribe(id), see PropertyNotifier.h
+* - TS_Property records lock statistics when PROPERTY_TELEMETRY is
+*   defined, see LockTelemetry.h
+* - locking is now a template policy instead of virtual methods, so
+*   properties have no vtable; TS_Property's mutex is no longer
+*   allocated on the heap
+* - replaced console messages from lock(), unlock(), set(), and get()
+*   with optional tracing, see PropertyTrace.h
+* - added move construction and assignment, swap(t), and take(), so
+*   values can be moved in and out without copying, plus rvalue
+*   push_back, push_front, push, and insert, and emplace_back,
+*   emplace_front, emplace, and try_emplace
+* - added SpinLock and Compact_Property<T>
+* - subscriber storage shrunk from three words to one
+* - added Aligned_Property<T, Lock, Align>
+* - added version(), incremented by every mutation
+* - mutators pass changed() a description of the change, recorded
+*   when PROPERTY_JOURNAL is defined, see PropertyJournal.h
+* - replaced MSVC-only spellings like typename const T::value_type
+*   with standard ones, so the package builds with GCC and Clang
+* - added watch(callback); thread-safe properties no longer copy
+*   their value for subscribers while holding the write lock
+* - mutators hold a WriteGuard, so an exception can't leave the
+*   lock held, and journal records are made before the value is
+*   changed, so a change that can't be recorded isn't made
+* - added WriteScope::commit(); WriteScope's destructor no longer
+*   lets an exception escape
 * ver 2.0 : 18 Aug 2019
 * - completely new design - better structure, safer functionaligy
 * ver 1.0 : 03 Jun 2019
@@ -41,29 +102,175 @@
 */
 
 #include <thread>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
+#include <shared_mutex>
 #include <type_traits>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
 #include <iostream>
 #include "../CustomContainerTypeTraits/CustomContTypeTraits.h"
+#include "PropertyNotifier.h"
+#include "PropertyTrace.h"
+#include "PropertyJournal.h"
+#ifdef PROPERTY_TELEMETRY
+#include "LockTelemetry.h"
+#endif
 
 ///////////////////////////////////////////////////////////////
-// PropContainer<T> class
-// - manages instance of the property
+// Lock policies
+// - each provides lock(), unlock(), lock_shared(), and
+//   unlock_shared(), called without any virtual dispatch
+// - PropertyOps<T, Lock> accepts any type with those methods
 
-template <typename T>
-class PropContainer {
+///////////////////////////////////////////////////////////////
+// NullLock
+// - default for PropContainer and PropertyBase, and used by
+//   Property<T>, compiles away entirely
+
+struct NullLock
+{
+  void lock() {}
+  void unlock() {}
+  void lock_shared() {}
+  void unlock_shared() {}
+};
+
+///////////////////////////////////////////////////////////////
+// MutexLock
+// - used by TS_Property<T>
+// - recursive, so a thread holding the lock may call any
+//   property operation
+
+class MutexLock
+{
+public:
+  void lock()
+  {
+    mtx_.lock();
+  }
+  bool try_lock()
+  {
+    return mtx_.try_lock();
+  }
+  void unlock()
+  {
+    mtx_.unlock();
+  }
+  void lock_shared()
+  {
+    lock();
+  }
+  void unlock_shared()
+  {
+    unlock();
+  }
+private:
+  std::recursive_mutex mtx_;
+};
+
+///////////////////////////////////////////////////////////////
+// SharedMutexLock
+// - used by RW_Property<T>, not recursive
+
+class SharedMutexLock
+{
 public:
-  //----< override to provide locking >--------------------
+  void lock()
+  {
+    mtx_.lock();
+  }
+  bool try_lock()
+  {
+    return mtx_.try_lock();
+  }
+  void unlock()
+  {
+    mtx_.unlock();
+  }
+  void lock_shared()
+  {
+    mtx_.lock_shared();
+  }
+  void unlock_shared()
+  {
+    mtx_.unlock_shared();
+  }
+private:
+  std::shared_mutex mtx_;
+};
+
+///////////////////////////////////////////////////////////////
+// SpinLock
+// - used by Compact_Property<T>, occupies one byte
+// - waiters spin on a plain load and yield, so they don't
+//   keep stealing the flag's cache line from the holder
+// - not recursive, and shared locking is exclusive
 
-  virtual void lock()
+class SpinLock
+{
+public:
+  void lock()
+  {
+    while (locked_.exchange(true, std::memory_order_acquire))
+    {
+      while (locked_.load(std::memory_order_relaxed))
+        std::this_thread::yield();
+    }
+  }
+  bool try_lock()
+  {
+    return !locked_.load(std::memory_order_relaxed) && !locked_.exchange(true, std::memory_order_acquire);
+  }
+  void unlock()
   {
-    std::cout << "\n---- called empty lock() ----";
+    locked_.store(false, std::memory_order_release);
   }
-  //----< override to provide locking >--------------------
+  void lock_shared()
+  {
+    lock();
+  }
+  void unlock_shared()
+  {
+    unlock();
+  }
+private:
+  std::atomic<bool> locked_ { false };
+};
 
-  virtual void unlock()
+///////////////////////////////////////////////////////////////
+// PropContainer<T, Lock> class
+// - manages instance of the property and its lock
+// - with PROPERTY_TRACE defined, records each lock, unlock,
+//   set, and get, see PropertyTrace.h; otherwise tracing
+//   generates no code
+// - with PROPERTY_JOURNAL defined, records each change made
+//   while attached to a journal, see PropertyJournal.h
+
+template <typename T, typename Lock = NullLock>
+class PropContainer {
+public:
+  void lock()
+  {
+    lock_.lock();
+    trace(PropertyTrace::Op::Lock);
+  }
+  void unlock()
   {
-    std::cout << "\n---- called empty unlock() ----";
+    trace(PropertyTrace::Op::Unlock);
+    lock_.unlock();
+  }
+  void lock_shared()
+  {
+    lock_.lock_shared();
+    trace(PropertyTrace::Op::LockShared);
+  }
+  void unlock_shared()
+  {
+    trace(PropertyTrace::Op::UnlockShared);
+    lock_.unlock_shared();
   }
 
   PropContainer() :t_(T()) {}
@@ -71,37 +278,252 @@ public:
   {
     set(t);
   }
-  virtual ~PropContainer() {}
+  PropContainer(T&& t)
+  {
+    set(std::move(t));
+  }
+  ~PropContainer()
+  {
+#ifdef PROPERTY_JOURNAL
+    if (pJournal_ != nullptr)
+      pJournal_->pJournal->detach(pJournal_);
+#endif
+    NotifierPtr* pNotifier = pNotifier_.load(std::memory_order_relaxed);
+    if (pNotifier != nullptr)
+      (*pNotifier)->detach();
+    delete pNotifier;
+  }
 
 protected:
+  using NotifierPtr = std::shared_ptr<ChangeNotifier<T>>;
+  using ReadGuard = std::shared_lock<PropContainer>;
+  using LockGuard = std::lock_guard<PropContainer>;
+
+  /////////////////////////////////////////////////////////////
+  // WriteGuard class
+  // - mutators hold one while changing the value, so the lock
+  //   is released however they exit
+  // - prepare(change) encodes the change's journal record before
+  //   the value is modified, so a change that can't be recorded
+  //   throws with the value untouched; without PROPERTY_JOURNAL
+  //   it generates no code
+  // - commit(change) publishes the change after the value is
+  //   modified, see changed(), using the prepared record if any
+
+  class WriteGuard
+  {
+  public:
+    WriteGuard(PropContainer& prop) : prop_(prop)
+    {
+      prop_.lock();
+      try
+      {
+        prop_.admit();
+      }
+      catch (...)
+      {
+        prop_.unlock();
+        throw;
+      }
+    }
+    ~WriteGuard()
+    {
+#ifdef PROPERTY_JOURNAL
+      if (record_.capacity() > 0)
+        PropertyJournal::Journal::scratch().swap(record_);
+#endif
+      prop_.unlock();
+    }
+    WriteGuard(const WriteGuard&) = delete;
+    WriteGuard& operator=(const WriteGuard&) = delete;
+
+    template<typename Change>
+    void prepare(const Change& change)
+    {
+      prepare(change, prop_.t_);
+    }
+    //----< Set changes encode basis, the value to be assigned >--
+
+    template<typename Change>
+    void prepare(const Change& change, const T& basis)
+    {
+#ifdef PROPERTY_JOURNAL
+      if constexpr (PropertySnapshot::isEncodable<T>())
+      {
+        if (prop_.pJournal_ != nullptr)
+        {
+          record_.swap(PropertyJournal::Journal::scratch());
+          prepared_ = prop_.pJournal_->pJournal->encode(*prop_.pJournal_, basis, change, record_);
+        }
+      }
+#else
+      (void)change;
+      (void)basis;
+#endif
+    }
+
+    template<typename Change = PropertyJournal::Set>
+    void commit(const Change& change = Change())
+    {
+#ifdef PROPERTY_JOURNAL
+      if (prepared_)
+      {
+        prepared_ = false;
+        prop_.advance();
+        prop_.pJournal_->pJournal->commit(*prop_.pJournal_, record_);
+        prop_.notify();
+        return;
+      }
+#endif
+      prop_.changed(change);
+    }
+
+  private:
+    PropContainer& prop_;
+#ifdef PROPERTY_JOURNAL
+    std::string record_;
+    bool prepared_ = false;
+#endif
+  };
 
-  //----< override to provide value management >-----------
+  //----< value management >-------------------------------
 
-  virtual void set(const T& t)
+  void set(const T& t)
   {
-    std::cout << "\n---- setting ----";
-    lock();
+    trace(PropertyTrace::Op::Set);
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::Set(), t);
     t_ = t;
-    unlock();
+    guard.commit();
+  }
+
+  void set(T&& t)
+  {
+    trace(PropertyTrace::Op::Set);
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::Set(), t);
+    t_ = std::move(t);
+    guard.commit();
   }
-  //----< override to provide value management >-----------
+  //----< value management >-------------------------------
 
-  virtual T& get()
+  T& get()
   {
-    std::cout << "\n---- getting ----";
+    trace(PropertyTrace::Op::Get);
     return t_;
   }
 
+  void trace(PropertyTrace::Op op)
+  {
+    if constexpr (PropertyTrace::enabled)
+      PropertyTrace::TraceSink::instance().record(this, op);
+  }
+  //----< called holding lock after writing, by WriteGuard >--
+  /*
+  *  Advances the version, journals the change, and notifies
+  *  subscribers.  Costs an atomic store and load when nothing
+  *  has subscribed or been journaled; the lock serializes
+  *  writers, so no read-modify-write is needed.  Changes
+  *  without a compact form pass none, journaling the value.
+  *  Only notifying can throw, and the change stands.
+  */
+  template<typename Change = PropertyJournal::Set>
+  void changed(const Change& change = Change())
+  {
+    advance();
+    journal(change);
+    notify();
+  }
+
+  void advance()
+  {
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+  //----< post to subscribers, if any >--------------------
+  /*
+  *  Subscribers' copy of the value is made later, by the
+  *  notify executor, except for unlocked properties.
+  */
+  void notify()
+  {
+    NotifierPtr* pNotifier = pNotifier_.load(std::memory_order_acquire);
+    if (pNotifier != nullptr)
+    {
+      if constexpr (std::is_same<Lock, NullLock>::value)
+        (*pNotifier)->post(t_);
+      else
+        (*pNotifier)->post();
+    }
+  }
+  //----< record change already made, if attached to a journal >--
+
+  template<typename Change>
+  void journal(const Change& change)
+  {
+#ifdef PROPERTY_JOURNAL
+    if constexpr (PropertySnapshot::isEncodable<T>())
+    {
+      if (pJournal_ != nullptr)
+        pJournal_->pJournal->append(*pJournal_, t_, change);
+    }
+#else
+    (void)change;
+#endif
+  }
+  //----< throws if an attached journal can't take changes yet >--
+
+  void admit()
+  {
+#ifdef PROPERTY_JOURNAL
+    if (pJournal_ != nullptr)
+      pJournal_->pJournal->admit();
+#endif
+  }
+  //----< create notifier on first use >-------------------
+  /*
+  *  The shared_ptr lives on the heap so properties that never
+  *  subscribe pay for only one pointer.  The executor may still
+  *  hold the notifier after the property is destroyed, so the
+  *  destructor detaches the source reading the value.
+  */
+  ChangeNotifier<T>& notifier()
+  {
+    NotifierPtr* pNotifier = pNotifier_.load(std::memory_order_acquire);
+    if (pNotifier == nullptr)
+    {
+      NotifierPtr* pNew = new NotifierPtr(std::make_shared<ChangeNotifier<T>>());
+      if constexpr (!std::is_same<Lock, NullLock>::value)
+      {
+        (*pNew)->attach([this]() {
+          std::shared_lock<PropContainer> lck(*this);
+          return std::make_shared<const T>(t_);
+        });
+      }
+      if (pNotifier_.compare_exchange_strong(pNotifier, pNew, std::memory_order_acq_rel))
+        pNotifier = pNew;
+      else
+        delete pNew;
+    }
+    return **pNotifier;
+  }
+
 protected:
   T t_;
+  Lock lock_;
+  std::atomic<std::uint64_t> version_ { 0 };
+  std::atomic<NotifierPtr*> pNotifier_ { nullptr };
+#ifdef PROPERTY_JOURNAL
+  PropertyJournal::Attachment* pJournal_ = nullptr;
+  friend class PropertyJournal::Journal;
+#endif
 };
 
 ///////////////////////////////////////////////////////////////
-// PropertyBase<T> class
+// PropertyBase<T, Lock> class
 // - provides user interface
 
-template <typename T>
-class PropertyBase : public PropContainer<T>
+template <typename T, typename Lock = NullLock>
+class PropertyBase : public PropContainer<T, Lock>
 {
 public:
   PropertyBase() {}
@@ -109,39 +531,210 @@ public:
   {
     this->set(t);
   }
-  virtual ~PropertyBase() {}
+  PropertyBase(T&& t)
+  {
+    this->set(std::move(t));
+  }
+  ~PropertyBase() {}
 
-  PropertyBase<T>(const PropertyBase<T>& prop) = delete;
-  PropertyBase<T>& operator=(const PropertyBase<T>& prop) = delete;
+  PropertyBase(const PropertyBase& prop) = delete;
+  PropertyBase& operator=(const PropertyBase& prop) = delete;
 
-  PropertyBase<T>& operator=(const T& t)
+  PropertyBase& operator=(const T& t)
   {
     this->set(t);
     return *this;
   }
+  PropertyBase& operator=(T&& t)
+  {
+    this->set(std::move(t));
+    return *this;
+  }
   void operator()(const T& t)
   {
     this->set(t);
   }
+  void operator()(T&& t)
+  {
+    this->set(std::move(t));
+  }
   T operator()()
   {
     // only one copy here due to return value optimization
-    this->lock();
-    T temp = this->get();
-    this->unlock();
+    ReadGuard lck(*this);
+    return this->get();
+  }
+  //----< exchange value with t, no copies for STL containers >--
+
+  void swap(T& t)
+  {
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::Set(), t);
+    using std::swap;
+    swap(this->get(), t);
+    guard.commit();
+  }
+  //----< move value out, leaving a default constructed T >------
+
+  T take()
+  {
+    WriteGuard guard(*this);
+    T fresh = T();
+    guard.prepare(PropertyJournal::Set(), fresh);
+    T temp = std::move(this->get());
+    this->get() = std::move(fresh);
+    guard.commit();
     return temp;
   }
+
+  /////////////////////////////////////////////////////////////
+  // WriteScope and ReadScope
+  // - hold the property's lock for their lifetime and give
+  //   access to the underlying value, so a batch of operations
+  //   costs one lock acquisition and other threads can't
+  //   interleave with it
+  // - don't call the property's own locking methods while
+  //   holding a scope on an RW_Property, its lock isn't recursive
+  // - don't let references to the value outlive the scope
+  // - WriteScope's commit() publishes the batch, and can throw
+  //   if subscribers can't be notified; call it after the last
+  //   write.  Otherwise the destructor publishes the batch, and
+  //   a failure to notify is lost, since it can't throw.
+
+  class WriteScope
+  {
+  public:
+    WriteScope(PropertyBase& prop) : prop_(prop), guard_(prop)
+    {
+    }
+    ~WriteScope()
+    {
+      if (committed_)
+        return;
+      try
+      {
+        guard_.commit();
+      }
+      catch (...) {}
+    }
+    WriteScope(const WriteScope&) = delete;
+    WriteScope& operator=(const WriteScope&) = delete;
+
+    void commit()
+    {
+      committed_ = true;
+      guard_.commit();
+    }
+
+    T& operator*() { return prop_.get(); }
+    T* operator->() { return &prop_.get(); }
+  private:
+    PropertyBase& prop_;
+    typename PropContainer<T, Lock>::WriteGuard guard_;
+    bool committed_ = false;
+  };
+
+  class ReadScope
+  {
+  public:
+    ReadScope(PropertyBase& prop) : prop_(prop)
+    {
+      prop_.lock_shared();
+    }
+    ~ReadScope()
+    {
+      prop_.unlock_shared();
+    }
+    ReadScope(const ReadScope&) = delete;
+    ReadScope& operator=(const ReadScope&) = delete;
+
+    const T& operator*() { return prop_.get(); }
+    const T* operator->() { return &prop_.get(); }
+  private:
+    PropertyBase& prop_;
+  };
+
+  //----< number of mutations so far, read without locking >----
+  /*
+  *  A reader caching the value can compare versions and only
+  *  read the value when they differ.  Read the version first:
+  *  the value read afterward is at least that new, so at worst
+  *  a later poll re-reads an unchanged value.  Writes through
+  *  non-const operator[] or iterators aren't counted, use
+  *  modify(f) or a WriteScope.
+  */
+  std::uint64_t version() const
+  {
+    return this->version_.load(std::memory_order_acquire);
+  }
+  //----< callback runs on NotifyExecutor's thread after writes >--
+  /*
+  *  Writes in a burst are coalesced, so cb may see only the
+  *  latest value.  Writes through non-const operator[] or
+  *  iterators aren't seen, use modify(f) or a WriteScope.
+  */
+  size_t subscribe(std::function<void(const T&)> cb)
+  {
+    return this->notifier().subscribe(std::move(cb));
+  }
+  //----< like subscribe, but cb isn't passed the value >--------
+  /*
+  *  Suits subscribers that read the value themselves, or not
+  *  at all, so no copy is made for them.
+  */
+  size_t watch(std::function<void()> cb)
+  {
+    return this->notifier().watch(std::move(cb));
+  }
+
+  bool unsubscribe(size_t id)
+  {
+    return this->notifier().unsubscribe(id);
+  }
+  //----< call f(T&) holding the lock once, return its result >---
+  /*
+  *  If f throws, the value may be partly changed, so the change
+  *  is still published.
+  */
+  template<typename F>
+  auto modify(F f)
+  {
+    WriteScope scope(*this);
+    if constexpr (std::is_void<decltype(f(*scope))>::value)
+    {
+      f(*scope);
+      scope.commit();
+    }
+    else
+    {
+      auto result = f(*scope);
+      scope.commit();
+      return result;
+    }
+  }
+  //----< call f(const T&) holding a shared lock once >-----------
+
+  template<typename F>
+  auto read(F f) const
+  {
+    ReadScope scope(*const_cast<PropertyBase*>(this));
+    return f(*scope);
+  }
 protected:
+  using ReadGuard = typename PropContainer<T, Lock>::ReadGuard;
+  using LockGuard = typename PropContainer<T, Lock>::LockGuard;
+  using WriteGuard = typename PropContainer<T, Lock>::WriteGuard;
 };
 
 ///////////////////////////////////////////////////////////////
-// PropertyOps<T> class
+// PropertyOps<T, Lock> class
 // - adds methods to interact with STL intances
+// - Lock template parameter is the locking policy
 // - Enabler template paramter is just to manage specialization
 //
 
-template<class T, class Enabler = void>
-class PropertyOps : public PropertyBase<T>
+template<class T, class Lock = NullLock, class Enabler = void>
+class PropertyOps : public PropertyBase<T, Lock>
 {
 public:
   PropertyOps() {}
@@ -149,12 +742,21 @@ public:
   {
     this->set(t);
   }
+  PropertyOps(T&& t)
+  {
+    this->set(std::move(t));
+  }
 
-  PropertyOps<T>& operator=(const T& t)
+  PropertyOps& operator=(const T& t)
   {
     this->set(t);
     return *this;
   }
+  PropertyOps& operator=(T&& t)
+  {
+    this->set(std::move(t));
+    return *this;
+  }
 };
 
 ///////////////////////////////////////////////////////////////
@@ -163,8 +765,8 @@ public:
 // - Second template parameter selects for STL sequence containers
 //
 
-template<class T>
-class PropertyOps<T, std::enable_if_t<is_stl_seq_container<T>::value>> : public PropertyBase<T>
+template<class T, class Lock>
+class PropertyOps<T, Lock, std::enable_if_t<is_stl_seq_container<T>::value>> : public PropertyBase<T, Lock>
 {
 public:
   using iterator = typename T::iterator;
@@ -174,64 +776,88 @@ public:
   {
     this->set(t);
   }
-  PropertyOps<T>& operator=(const T& t)
+  PropertyOps(T&& t)
+  {
+    this->set(std::move(t));
+  }
+  PropertyOps& operator=(const T& t)
   {
     //std::cout << "\n-------- calling operator=(const T& t) ----------";
     this->set(t);
     return *this;
   }
+  PropertyOps& operator=(T&& t)
+  {
+    this->set(std::move(t));
+    return *this;
+  }
 
   iterator begin() {
     T& t = (*this).get();
-    this->lock();
-    iterator beg = t.begin();
-    this->unlock();
-    return beg;
+    ReadGuard lck(*this);
+    return t.begin();
   }
 
   iterator end() {
     T& t = (*this).get();
-    this->lock();
-    iterator end = t.end();
-    this->unlock();
-    return end;
+    ReadGuard lck(*this);
+    return t.end();
   }
 
   size_t size()
   {
     T& t = this->get();
-    this->lock();
-    size_t sz = t.size();
-    this->unlock();
-    return sz;
+    ReadGuard lck(*this);
+    return t.size();
   }
 
-  typename iterator insert(iterator iter, typename const T::value_type & value)
+  iterator insert(iterator iter, const typename T::value_type& value)
   {
     T& t = this->get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::InsertAt(iter, value));
     iterator curr = t.insert(iter, value);
-    this->unlock();
+    guard.commit();
     return curr;
   }
 
-  typename iterator erase(iterator iter)
+  iterator insert(iterator iter, typename T::value_type&& value)
   {
     T& t = this->get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::InsertAt(iter, value));
+    iterator curr = t.insert(iter, std::move(value));
+    guard.commit();
+    return curr;
+  }
+  //----< construct item in place before iter >------------
+
+  template<typename... Args>
+  iterator emplace(iterator iter, Args&&... args)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    iterator curr = t.emplace(iter, std::forward<Args>(args)...);
+    guard.commit(PropertyJournal::Insert(curr));
+    return curr;
+  }
+
+  iterator erase(iterator iter)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::Erase(iter, std::next(iter)));
     iterator next = t.erase(iter);
-    this->unlock();
+    guard.commit();
     return next;
   }
 
   typename T::value_type operator[](int n) const
   {
-    PropertyOps<T>* pPAPP = const_cast<PropertyOps<T>*>(this);
+    PropertyOps* pPAPP = const_cast<PropertyOps*>(this);
     T& t = pPAPP->get();
-    pPAPP->lock();
-    typename T::value_type v = t[n];
-    pPAPP->unlock();
-    return v;
+    ReadGuard lck(*pPAPP);
+    return t[n];
   }
   /*
   *  This non-const operator[] is not thread safe because it returns a
@@ -241,7 +867,7 @@ public:
   */
   typename T::value_type& operator[](int n)
   {
-    PropertyOps<T>* pPAPP = const_cast<PropertyOps<T>*>(this);
+    PropertyOps* pPAPP = const_cast<PropertyOps*>(this);
     T& t = pPAPP->get();
     typename T::value_type& v = t[n];
     return v;
@@ -250,76 +876,253 @@ public:
   typename T::value_type top()
   {
     T& t = (*this).get();
-    this->lock();
-    typename T::value_type top = t.top();
-    this->unlock();
-    return top;
+    ReadGuard lck(*this);
+    return t.top();
   }
 
-  void push(typename const T::value_type& v)
+  void push(const typename T::value_type& v)
   {
     T& t = (*this).get();
-    this->lock();
+    WriteGuard guard(*this);
     t.push(v);
-    this->unlock();
+    guard.commit();
+  }
+
+  void push(typename T::value_type&& v)
+  {
+    T& t = (*this).get();
+    WriteGuard guard(*this);
+    t.push(std::move(v));
+    guard.commit();
   }
 
   void pop()
   {
     T& t = (*this).get();
-    this->lock();
+    WriteGuard guard(*this);
     t.pop();
-    this->unlock();
+    guard.commit();
   }
 
-  void push_back(typename const T::value_type& v)
+  void push_back(const typename T::value_type& v)
   {
     T& t = (*this).get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::PushBack(v));
     t.push_back(v);
-    this->unlock();
+    guard.commit();
+  }
+
+  void push_back(typename T::value_type&& v)
+  {
+    T& t = (*this).get();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::PushBack(v));
+    t.push_back(std::move(v));
+    guard.commit();
+  }
+  //----< construct item in place at end >-----------------
+  /*
+  *  Doesn't return a reference to the new item, as the STL
+  *  containers do, since it couldn't be used safely after
+  *  the lock is released.
+  */
+  template<typename... Args>
+  void emplace_back(Args&&... args)
+  {
+    T& t = (*this).get();
+    WriteGuard guard(*this);
+    t.emplace_back(std::forward<Args>(args)...);
+    guard.commit(PropertyJournal::PushBack(t.back()));
   }
 
-  void push_front(typename const T::value_type& v)
+  void push_front(const typename T::value_type& v)
   {
     T& t = (*this).get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::PushFront(v));
     t.push_front(v);
-    this->unlock();
+    guard.commit();
+  }
+
+  void push_front(typename T::value_type&& v)
+  {
+    T& t = (*this).get();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::PushFront(v));
+    t.push_front(std::move(v));
+    guard.commit();
+  }
+
+  template<typename... Args>
+  void emplace_front(Args&&... args)
+  {
+    T& t = (*this).get();
+    WriteGuard guard(*this);
+    t.emplace_front(std::forward<Args>(args)...);
+    guard.commit(PropertyJournal::PushFront(t.front()));
   }
 
   typename T::value_type front()
   {
     T& t = (*this).get();
-    this->lock();
-    typename T::value_type front = t.front();
-    this->unlock();
-    return front;
+    ReadGuard lck(*this);
+    return t.front();
   }
 
   typename T::value_type back()
   {
     T& t = (*this).get();
-    this->lock();
-    typename T::value_type back = t.back();
-    this->unlock();
-    return back;
+    ReadGuard lck(*this);
+    return t.back();
   }
 
   void pop_back()
   {
     T& t = (*this).get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::PopBack());
     t.pop_back();
-    this->unlock();
+    guard.commit();
   }
 
   void pop_front()
   {
     T& t = (*this).get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::PopFront());
     t.pop_front();
-    this->unlock();
+    guard.commit();
+  }
+
+  //----< range operations, each takes the lock once >-----------
+  /*
+  *  The InputIt overloads are disabled for integral types so that,
+  *  as with the STL containers, insert(iter, 3, 4) isn't taken
+  *  to be an iterator range.  A forward range is journaled before
+  *  it's appended; an input range can be read only once, so it's
+  *  journaled afterward.
+  */
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void append(InputIt first, InputIt last)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    if constexpr (isForward<InputIt>())
+    {
+      guard.prepare(PropertyJournal::AppendRange(first, last));
+      appendRange(t, first, last);
+      guard.commit();
+    }
+    else
+    {
+      size_t before = t.size();
+      appendRange(t, first, last);
+      guard.commit(PropertyJournal::Append(t.size() - before));
+    }
+  }
+
+  void append(std::initializer_list<typename T::value_type> items)
+  {
+    append(items.begin(), items.end());
+  }
+
+  void append(T&& items)
+  {
+    append(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+  }
+
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  iterator insert(iterator iter, InputIt first, InputIt last)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    iterator curr = t.insert(iter, first, last);
+    guard.commit();
+    return curr;
+  }
+
+  iterator insert(iterator iter, std::initializer_list<typename T::value_type> items)
+  {
+    return insert(iter, items.begin(), items.end());
+  }
+
+  iterator erase(iterator first, iterator last)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::Erase(first, last));
+    iterator next = t.erase(first, last);
+    guard.commit();
+    return next;
+  }
+
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void assign(InputIt first, InputIt last)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    t.assign(first, last);
+    guard.commit();
+  }
+
+  void assign(std::initializer_list<typename T::value_type> items)
+  {
+    assign(items.begin(), items.end());
+  }
+
+  void resize(size_t n)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    t.resize(n);
+    guard.commit();
+  }
+
+  void resize(size_t n, const typename T::value_type& v)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    t.resize(n, v);
+    guard.commit();
+  }
+
+  void reserve(size_t n)
+  {
+    T& t = this->get();
+    LockGuard lck(*this);
+    t.reserve(n);
+  }
+
+  void shrink_to_fit()
+  {
+    T& t = this->get();
+    LockGuard lck(*this);
+    t.shrink_to_fit();
+  }
+
+protected:
+  using ReadGuard = typename PropertyBase<T, Lock>::ReadGuard;
+  using LockGuard = typename PropertyBase<T, Lock>::LockGuard;
+  using WriteGuard = typename PropertyBase<T, Lock>::WriteGuard;
+
+private:
+  template<typename InputIt>
+  static constexpr bool isForward()
+  {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    return std::is_base_of<std::forward_iterator_tag, category>::value;
+  }
+  //----< reserve once for forward ranges, then insert at end >--
+
+  template<typename InputIt>
+  static void appendRange(T& t, InputIt first, InputIt last)
+  {
+    if constexpr (has_reserve<T>::value && isForward<InputIt>())
+    {
+      t.reserve(t.size() + static_cast<size_t>(std::distance(first, last)));
+    }
+    t.insert(t.end(), first, last);
   }
 };
 
@@ -329,8 +1132,8 @@ public:
 // - Second template parameter selects for associative containers
 // - A few more operations would be useful like operator[]
 
-template<class T>
-class PropertyOps<T, std::enable_if_t<is_stl_assoc_container<T>::value>> : public PropertyBase<T>
+template<class T, class Lock>
+class PropertyOps<T, Lock, std::enable_if_t<is_stl_assoc_container<T>::value>> : public PropertyBase<T, Lock>
 {
 public:
   using iterator = typename T::iterator;
@@ -344,100 +1147,148 @@ public:
   {
     this->set(t);
   }
+  PropertyOps(T&& t)
+  {
+    this->set(std::move(t));
+  }
 
-  PropertyOps<T>& operator=(const T& t)
+  PropertyOps& operator=(const T& t)
   {
     this->set(t);
     return *this;
   }
+  PropertyOps& operator=(T&& t)
+  {
+    this->set(std::move(t));
+    return *this;
+  }
 
   iterator begin() {
     T& t = (*this).get();
-    this->lock();
-    iterator beg = t.begin();
-    this->unlock();
-    return beg;
+    ReadGuard lck(*this);
+    return t.begin();
   }
 
   iterator end() {
     T& t = (*this).get();
-    this->lock();
-    iterator end = t.end();
-    this->unlock();
-    return end;
+    ReadGuard lck(*this);
+    return t.end();
   }
 
   size_t size()
   {
     T& t = this->get();
-    this->lock();
-    size_t sz = t.size();
-    this->unlock();
-    return sz;
+    ReadGuard lck(*this);
+    return t.size();
   }
 
-  typename iterator insert(iterator iter, typename const T::value_type& value)
+  //----< insert near iter >------------------------------
+  /*
+  *  A multimap may place the item anywhere among those with an
+  *  equal key, so where it went is journaled afterward.
+  */
+  iterator insert(iterator iter, const typename T::value_type& value)
   {
     T& t = this->get();
-    this->lock();
-    iterator curr = t.insert(iter, value);
-    this->unlock();
-    return curr;
+    WriteGuard guard(*this);
+    if constexpr (PropertyJournal::detail::isMulti<T>())
+    {
+      iterator curr = t.insert(iter, value);
+      guard.commit(PropertyJournal::Insert(curr));
+      return curr;
+    }
+    else
+    {
+      guard.prepare(PropertyJournal::InsertItem(value));
+      iterator curr = t.insert(iter, value);
+      guard.commit();
+      return curr;
+    }
   }
 
-  typename auto insert(typename const T::value_type& value)
+  auto insert(const typename T::value_type& value)
   {
     T& t = this->get();
-    this->lock();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::InsertItem(value));
     auto curr = t.insert(value);
-    this->unlock();
+    guard.commit();
+    return curr;
+  }
+
+  auto insert(value_type&& value)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::InsertItem(value));
+    auto curr = t.insert(std::move(value));
+    guard.commit();
     return curr;
   }
+  //----< construct item in place >------------------------
 
-  typename iterator erase(iterator iter)
+  template<typename... Args>
+  auto emplace(Args&&... args)
   {
     T& t = this->get();
-    this->lock();
+    WriteGuard guard(*this);
+    auto curr = t.emplace(std::forward<Args>(args)...);
+    guard.commit(PropertyJournal::Insert(curr));
+    return curr;
+  }
+  //----< construct mapped value only if key is absent >---
+  /*
+  *  Unlike emplace, args aren't moved from if key exists.
+  *  Maps only.
+  */
+  template<typename... Args>
+  auto try_emplace(const key_type& key, Args&&... args)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    auto curr = t.try_emplace(key, std::forward<Args>(args)...);
+    if (curr.second)
+      guard.commit(PropertyJournal::Insert(curr));
+    return curr;
+  }
+
+  iterator erase(iterator iter)
+  {
+    T& t = this->get();
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::EraseKey(iter));
     iterator next = t.erase(iter);
-    this->unlock();
+    guard.commit();
     return next;
   }
 
-  typename const_iterator find(const key_type& key)
+  const_iterator find(const key_type& key)
   {
     T& t = this->get();
-    this->lock();
-    const_iterator found = t.find(key);
-    this->unlock();
-    return found;
+    ReadGuard lck(*this);
+    return t.find(key);
   }
 
   bool contains(const key_type& key) const
   {
-    PropertyOps<T>* pPAPP = const_cast<PropertyOps<T>*>(this);
+    PropertyOps* pPAPP = const_cast<PropertyOps*>(this);
     T& t = pPAPP->get();
-    pPAPP->lock();
-    const_iterator found = t.find(key);
-    iterator end = t.end();
-    pPAPP->unlock();
-    return found != end;
+    ReadGuard lck(*pPAPP);
+    return t.find(key) != t.end();
   }
 
   const typename T::mapped_type operator[](const key_type& key) const
   {
-    key_type savedKey = key;
-
-    PropertyOps<T>* pPAPP = const_cast<PropertyOps<T>*>(this);
+    PropertyOps* pPAPP = const_cast<PropertyOps*>(this);
     T& t = pPAPP->get();
-    if (!contains(key))
+    ReadGuard lck(*pPAPP);
+    const_iterator found = t.find(key);
+    if (found == t.end())
     {
       std::invalid_argument exc("exception: key not found");
       throw(exc);
     }
-    pPAPP->lock();
-    const typename T::mapped_type v = t[key];
-    pPAPP->unlock();
-    return v;
+    return found->second;
   }
   /*
   * - This method is a replacement for mapProperty[key] = value.
@@ -454,27 +1305,35 @@ public:
     std::pair<key_type, mapped_type> item;
     item.first = key;
     item.second = value;
+    WriteGuard guard(*this);
+    guard.prepare(PropertyJournal::EditItem(key, value));
     iterator iter = t.find(key);
     bool rtn = true;
     if (iter == t.end())
     {
-      bool rtn = false;
-      insert(item);
+      rtn = false;
+      t.insert(item);
     }
     else
     {
       iter->second = value;
     }
+    guard.commit();
     return rtn;
   }
+
+protected:
+  using ReadGuard = typename PropertyBase<T, Lock>::ReadGuard;
+  using WriteGuard = typename PropertyBase<T, Lock>::WriteGuard;
 };
 
 ///////////////////////////////////////////////////////////////
 // Property<T> class
+// - no locking, for use by a single thread
 //
 
 template<typename T>
-class Property : public PropertyOps<T>
+class Property : public PropertyOps<T, NullLock>
 {
 public:
   Property() {}
@@ -482,119 +1341,186 @@ public:
   {
     this->set(t);
   }
+  Property(T&& t)
+  {
+    this->set(std::move(t));
+  }
   ~Property() {}
 
   void operator=(const T& t)
   {
     this->set(t);
   }
+  void operator=(T&& t)
+  {
+    this->set(std::move(t));
+  }
+};
 
-protected:
+///////////////////////////////////////////////////////////////
+// TS_Property<T> class
+// - Provides type-safe operations for all but indexing
+//   and iteration.
+// - For those you need to embedd them between lock() and
+//   unlock() calls.
+// - With PROPERTY_TELEMETRY defined, its lock records
+//   contention statistics, see LockTelemetry.h
+//
 
-  //----< override to provide value management >-----------
+#ifdef PROPERTY_TELEMETRY
+using TS_PropertyLock = InstrumentedLock<MutexLock>;
+#else
+using TS_PropertyLock = MutexLock;
+#endif
 
-  virtual void set(const T& t) override
+template<typename T>
+class TS_Property : public PropertyOps<T, TS_PropertyLock>
+{
+public:
+  TS_Property() {}
+  TS_Property(const T& t)
   {
-    //std::cout << "\n---- setting ----";
-    this->t_ = t;
+    this->set(t);
   }
-  //----< override to provide value management >-----------
-
-  virtual T& get() override
+  TS_Property(T&& t)
   {
-    //std::cout << "\n---- getting ----";
-    return this->t_;
+    this->set(std::move(t));
   }
-  //----< override to remove lock enunciation >------------
+  ~TS_Property() {}
 
-  virtual void lock() override
+  void operator=(const T& t)
   {
-  
+    this->set(t);
   }
-  //----< override to remove unlock enunciation >----------
-
-  virtual void unlock() override
+  void operator=(T&& t)
   {
+    this->set(std::move(t));
+  }
+  //----< tags lock statistics, set before sharing property >---
 
+  void telemetryName(const std::string& name)
+  {
+#ifdef PROPERTY_TELEMETRY
+    this->lock_.name(name);
+#else
+    (void)name;
+#endif
   }
 };
 
 ///////////////////////////////////////////////////////////////
-// TS_Property<T> class
-// - Provides type-safe operations for all but indexing
-//   and iteration.
-// - For those you need to embedd them between lock() and
-//   unlock() calls.
+// RW_Property<T> class
+// - Thread-safe like TS_Property<T>, but uses a reader-writer
+//   lock.  Read-only operations, e.g., operator()(), size(),
+//   front(), find(), and contains(), take a shared lock so
+//   readers don't serialize against each other.  Mutators
+//   take an exclusive lock.
+// - The lock is not recursive, so don't call lock() or
+//   lock_shared() while already holding it.
+// - Indexing and iteration still need to be embedded between
+//   lock() and unlock() calls, or lock_shared() and
+//   unlock_shared() calls when only reading.
 //
 
 template<typename T>
-class TS_Property : public PropertyOps<T>
+class RW_Property : public PropertyOps<T, SharedMutexLock>
 {
 public:
-  TS_Property() : pMtx(new std::recursive_mutex), lck(*pMtx)
-  {
-    testLock();
-  }
-  TS_Property(const T& t) : pMtx(new std::recursive_mutex), lck(*pMtx)
+  RW_Property() {}
+  RW_Property(const T& t)
   {
-    testLock();
     this->set(t);
   }
-  ~TS_Property()
+  RW_Property(T&& t)
   {
-    pMtx->unlock();
-    delete pMtx;
+    this->set(std::move(t));
   }
+  ~RW_Property() {}
 
   void operator=(const T& t)
   {
     this->set(t);
   }
-  virtual void lock() override
+  void operator=(T&& t)
   {
-    //std::cout << "\n  ---- taking lock ----";
-    lck.lock();
+    this->set(std::move(t));
   }
-  virtual void unlock() override
+};
+
+///////////////////////////////////////////////////////////////
+// Compact_Property<T> class
+// - Thread-safe like TS_Property<T>, but its lock is a one
+//   byte SpinLock held inline, so a Compact_Property<int>
+//   occupies three words, the value and lock, the version
+//   counter, and the subscriber pointer, and constructing one
+//   allocates nothing.
+// - Suits short critical sections on small values.  The lock
+//   is not recursive, and waiters spin, so don't hold it
+//   across long or blocking work.
+//
+
+template<typename T>
+class Compact_Property : public PropertyOps<T, SpinLock>
+{
+public:
+  Compact_Property() {}
+  Compact_Property(const T& t)
+  {
+    this->set(t);
+  }
+  Compact_Property(T&& t)
   {
-    //std::cout << "\n  ---- releasing lock ----";
-    lck.unlock();
+    this->set(std::move(t));
   }
+  ~Compact_Property() {}
 
-protected:
+  void operator=(const T& t)
+  {
+    this->set(t);
+  }
+  void operator=(T&& t)
+  {
+    this->set(std::move(t));
+  }
+};
 
-  //----< override to provide value management >-----------
+///////////////////////////////////////////////////////////////
+// Aligned_Property<T, Lock, Align> class
+// - Same operations as PropertyOps<T, Lock>, thread-safe with
+//   the default lock, but aligned to, and padded to a multiple
+//   of, Align bytes.
+// - Use for arrays of properties written by different threads,
+//   e.g., per-worker counters, so one worker's writes don't
+//   invalidate the cache line holding its neighbor's property.
+//   A lone property gains nothing but size.
+// - Align defaults to 64, the line size of current x86 and
+//   most ARM processors; use 128 where adjacent line prefetch
+//   pairs lines.
+//
 
-  virtual void set(const T& t) override
+template<typename T, typename Lock = TS_PropertyLock, size_t Align = 64>
+class alignas(Align) Aligned_Property : public PropertyOps<T, Lock>
+{
+public:
+  Aligned_Property() {}
+  Aligned_Property(const T& t)
   {
-    //std::cout << "\n---- setting ----";
-    this->t_ = t;
+    this->set(t);
   }
-  //----< override to provide value management >-----------
-
-  virtual T& get() override
+  Aligned_Property(T&& t)
   {
-    //std::cout << "\n---- getting ----";
-    return this->t_;
+    this->set(std::move(t));
   }
+  ~Aligned_Property() {}
 
-  bool testLock()
+  void operator=(const T& t)
   {
-    if (pMtx->try_lock() == true)
-    {
-      //std::cout << "\n  ---- not previously locked ----";
-      lck.unlock();
-      return false;
-    }
-    else
-    {
-      //std::cout << "\n  ---- previously locked ----";
-      return true;
-    }
+    this->set(t);
+  }
+  void operator=(T&& t)
+  {
+    this->set(std::move(t));
   }
-
-  std::recursive_mutex* pMtx;
-  std::unique_lock<std::recursive_mutex> lck;
 };
 
 ///////////////////////////////////////////////////////////
@@ -0,0 +1,458 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyBinding.h - Dataflow bindings between properties        //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* - BindingEngine
+*     engine.bind(target, f, sources...) makes property target hold
+*     f(values of sources...), and keeps it so as sources change.
+*     Sources written by the program are roots; a target may be the
+*     source of later bindings, so bindings form a graph.
+*     - Each node has a level, one more than its deepest input.  A
+*       propagation wave evaluates affected nodes level by level, so
+*       a node runs only after all of its inputs are up to date, and
+*       never sees a mix of old and new inputs.
+*     - Nodes within a level are independent and are evaluated in
+*       parallel on PropertyParallel::WorkerPool.
+*     - Root writes are noticed through watch(), so a burst of
+*       writes is coalesced.  A wave checks every root's version(),
+*       so all roots written before it starts are propagated by
+*       that one wave.
+*     - batch(f) runs f, deferring waves until it returns, so roots
+*       written together are always propagated together.
+*     - settle() propagates everything written so far and waits.
+*
+* Root values are copied once per wave, when the wave starts, and
+* every node in the wave sees those copies.  Targets are written
+* only by the engine; writes to them from elsewhere are overwritten
+* by the next wave that reaches them.
+*
+* Required Files:
+* ---------------
+* PropertyBinding.h, PropertyParallel.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - roots are watched instead of subscribed, so writes to a root
+*   don't copy its value for the engine
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "PropertyParallel.h"
+
+namespace PropertyBinding {
+
+  template<typename P>
+  using value_t = std::decay_t<decltype(std::declval<P&>()())>;
+
+  /////////////////////////////////////////////////////////////
+  // NodeBase class
+  // - one node per property in the graph
+
+  class NodeBase
+  {
+  public:
+    virtual ~NodeBase() {}
+    virtual void evaluate() {}
+
+    size_t level = 0;
+    std::vector<NodeBase*> outputs;
+    std::uint64_t wave = 0;  // last wave that scheduled this node
+  };
+
+  template<typename T>
+  class ValueNode : public NodeBase
+  {
+  public:
+    std::shared_ptr<const T> value;
+  };
+
+  /////////////////////////////////////////////////////////////
+  // RootNode<P> class
+  // - holds the copy of a root property's value used by the
+  //   current wave
+
+  class RootBase
+  {
+  public:
+    virtual ~RootBase() {}
+    virtual bool stale() const = 0;
+    virtual void snapshot() = 0;
+    virtual NodeBase* node() = 0;
+  };
+
+  template<typename P>
+  class RootNode : public ValueNode<value_t<P>>, public RootBase
+  {
+  public:
+    using T = value_t<P>;
+
+    RootNode(P& prop) : prop_(prop)
+    {
+      snapshot();
+    }
+    ~RootNode()
+    {
+      prop_.unsubscribe(subscription);
+    }
+
+    virtual bool stale() const override
+    {
+      return prop_.version() != version_;
+    }
+    //----< read version first, so the copy is at least as new >--
+
+    virtual void snapshot() override
+    {
+      version_ = prop_.version();
+      this->value = std::make_shared<const T>(prop_());
+    }
+
+    virtual NodeBase* node() override
+    {
+      return this;
+    }
+
+    P& prop()
+    {
+      return prop_;
+    }
+
+    size_t subscription = 0;
+
+  private:
+    P& prop_;
+    std::uint64_t version_ = 0;
+  };
+
+  /////////////////////////////////////////////////////////////
+  // BoundNode<P, Ins...> class
+  // - computes its target's value from its inputs' values
+
+  template<typename P, typename... Ins>
+  class BoundNode : public ValueNode<value_t<P>>
+  {
+  public:
+    using T = value_t<P>;
+    using Function = std::function<T(const Ins&...)>;
+
+    BoundNode(P& target, Function f, ValueNode<Ins>*... inputs)
+      : target_(target), f_(std::move(f)), inputs_(inputs...) {}
+
+    virtual void evaluate() override
+    {
+      T result = std::apply([this](ValueNode<Ins>*... inputs) { return f_(*inputs->value...); }, inputs_);
+      target_ = result;
+      this->value = std::make_shared<const T>(std::move(result));
+    }
+
+  private:
+    P& target_;
+    Function f_;
+    std::tuple<ValueNode<Ins>*...> inputs_;
+  };
+
+  /////////////////////////////////////////////////////////////
+  // BindingEngine class
+  // - graphMtx_ guards the graph and is held for a whole wave;
+  //   Signal::mtx guards pending roots and is taken after it
+  // - subscriptions hold only a weak_ptr to Signal, so a late
+  //   notification after the engine is destroyed does nothing
+  // - source and target properties must outlive the engine
+
+  class BindingEngine
+  {
+  public:
+    static constexpr size_t NodesPerPart = 64;
+
+    BindingEngine() : pSignal_(std::make_shared<Signal>())
+    {
+      waveThread_ = std::thread([this]() { run(); });
+    }
+    ~BindingEngine()
+    {
+      {
+        std::lock_guard<std::mutex> lck(pSignal_->mtx);
+        pSignal_->stop = true;
+      }
+      pSignal_->cv.notify_all();
+      waveThread_.join();
+    }
+    BindingEngine(const BindingEngine&) = delete;
+    BindingEngine& operator=(const BindingEngine&) = delete;
+
+    //----< bind target to f(values of sources...) >-----------
+    /*
+    *  Evaluates f once before returning.  Throws
+    *  std::invalid_argument if target is already in the graph,
+    *  so bind upstream targets before binding their dependents.
+    */
+    template<typename P, typename F, typename... Sources>
+    void bind(P& target, F f, Sources&... sources)
+    {
+      static_assert(sizeof...(Sources) > 0, "bind needs at least one source");
+      std::lock_guard<std::mutex> lck(graphMtx_);
+      if (nodes_.find(&target) != nodes_.end())
+        throw std::invalid_argument("exception: property is already in the binding graph");
+      if (((static_cast<const void*>(&sources) == &target) || ...))
+        throw std::invalid_argument("exception: property can't be bound to itself");
+      auto pNode = std::make_unique<BoundNode<P, value_t<Sources>...>>(
+        target, typename BoundNode<P, value_t<Sources>...>::Function(std::move(f)), findOrAddRoot(sources)...
+      );
+      std::initializer_list<NodeBase*> inputs = { static_cast<NodeBase*>(nodes_[&sources])... };
+      for (NodeBase* pInput : inputs)
+        pNode->level = std::max(pNode->level, pInput->level + 1);
+      pNode->evaluate();
+      for (NodeBase* pInput : inputs)
+        pInput->outputs.push_back(pNode.get());
+      nodes_[&target] = pNode.get();
+      owned_.push_back(std::move(pNode));
+    }
+    //----< defer waves until f returns >----------------------
+    /*
+    *  Don't call while holding a source property's lock.
+    */
+    template<typename F>
+    void batch(F f)
+    {
+      BatchScope scope(*pSignal_);
+      f();
+    }
+    //----< propagate all writes made so far, then wait >------
+    /*
+    *  Rethrows the first exception thrown by a bound function
+    *  since the last settle().
+    */
+    void settle()
+    {
+      {
+        std::lock_guard<std::mutex> graphLck(graphMtx_);
+        std::lock_guard<std::mutex> lck(pSignal_->mtx);
+        for (size_t id = 0; id < roots_.size(); ++id)
+        {
+          if (roots_[id]->stale())
+            pSignal_->pending.push_back(id);
+        }
+      }
+      pSignal_->cv.notify_all();
+      std::unique_lock<std::mutex> lck(pSignal_->mtx);
+      pSignal_->idle.wait(lck, [this]() {
+        return (pSignal_->pending.empty() && !pSignal_->waveRunning) || pSignal_->stop;
+      });
+      if (pError_)
+      {
+        std::exception_ptr pError = pError_;
+        pError_ = nullptr;
+        std::rethrow_exception(pError);
+      }
+    }
+
+    std::uint64_t waveCount()
+    {
+      std::lock_guard<std::mutex> lck(pSignal_->mtx);
+      return waves_;
+    }
+
+    size_t nodeCount()
+    {
+      std::lock_guard<std::mutex> lck(graphMtx_);
+      return nodes_.size();
+    }
+
+  private:
+    struct Signal
+    {
+      std::mutex mtx;
+      std::condition_variable cv;
+      std::condition_variable idle;
+      std::vector<size_t> pending;  // ids of written roots
+      size_t batchDepth = 0;
+      bool waveRunning = false;
+      bool stop = false;
+
+      void markPending(size_t id)
+      {
+        {
+          std::lock_guard<std::mutex> lck(mtx);
+          pending.push_back(id);
+        }
+        cv.notify_all();
+      }
+    };
+
+    class BatchScope
+    {
+    public:
+      BatchScope(Signal& signal) : signal_(signal)
+      {
+        std::lock_guard<std::mutex> lck(signal_.mtx);
+        ++signal_.batchDepth;
+      }
+      ~BatchScope()
+      {
+        {
+          std::lock_guard<std::mutex> lck(signal_.mtx);
+          --signal_.batchDepth;
+        }
+        signal_.cv.notify_all();
+      }
+    private:
+      Signal& signal_;
+    };
+
+    //----< caller holds graphMtx_ >---------------------------
+
+    template<typename P>
+    ValueNode<value_t<P>>* findOrAddRoot(P& prop)
+    {
+      auto iter = nodes_.find(&prop);
+      if (iter != nodes_.end())
+        return static_cast<ValueNode<value_t<P>>*>(iter->second);
+
+      auto pRoot = std::make_unique<RootNode<P>>(prop);
+      size_t id = roots_.size();
+      std::weak_ptr<Signal> pSignal = pSignal_;
+      pRoot->subscription = prop.watch([pSignal, id]() {
+        if (std::shared_ptr<Signal> pLive = pSignal.lock())
+          pLive->markPending(id);
+      });
+      RootNode<P>* pNode = pRoot.get();
+      nodes_[&prop] = pNode;
+      roots_.push_back(pNode);
+      owned_.push_back(std::move(pRoot));
+      return pNode;
+    }
+    //----< wave thread >--------------------------------------
+
+    void run()
+    {
+      for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> lck(pSignal_->mtx);
+          pSignal_->cv.wait(lck, [this]() {
+            return pSignal_->stop || (!pSignal_->pending.empty() && pSignal_->batchDepth == 0);
+          });
+          if (pSignal_->stop)
+          {
+            pSignal_->idle.notify_all();
+            return;
+          }
+        }
+        std::lock_guard<std::mutex> graphLck(graphMtx_);
+        std::vector<NodeBase*> changed;
+        {
+          std::lock_guard<std::mutex> lck(pSignal_->mtx);
+          if (pSignal_->pending.empty() || pSignal_->batchDepth != 0)
+            continue;
+          pSignal_->pending.clear();
+          ++waveId_;
+          for (RootBase* pRoot : roots_)
+          {
+            if (pRoot->stale())
+            {
+              pRoot->snapshot();
+              pRoot->node()->wave = waveId_;
+              changed.push_back(pRoot->node());
+            }
+          }
+          if (!changed.empty())
+            ++waves_;
+          pSignal_->waveRunning = true;
+        }
+        propagate(changed);
+        {
+          std::lock_guard<std::mutex> lck(pSignal_->mtx);
+          pSignal_->waveRunning = false;
+        }
+        pSignal_->idle.notify_all();
+      }
+    }
+    //----< evaluate nodes reachable from changed, by level >--
+
+    void propagate(const std::vector<NodeBase*>& changed)
+    {
+      std::vector<std::vector<NodeBase*>> levels;
+      std::vector<NodeBase*> frontier = changed;
+      while (!frontier.empty())
+      {
+        NodeBase* pNode = frontier.back();
+        frontier.pop_back();
+        for (NodeBase* pOut : pNode->outputs)
+        {
+          if (pOut->wave == waveId_)
+            continue;
+          pOut->wave = waveId_;
+          if (levels.size() <= pOut->level)
+            levels.resize(pOut->level + 1);
+          levels[pOut->level].push_back(pOut);
+          frontier.push_back(pOut);
+        }
+      }
+      for (auto& level : levels)
+      {
+        size_t parts = (level.size() + NodesPerPart - 1) / NodesPerPart;
+        if (parts <= 1)
+        {
+          evaluate(level, 0, level.size());
+          continue;
+        }
+        PropertyParallel::WorkerPool::instance().parallel_for(parts, [&](size_t part) {
+          evaluate(level, part * NodesPerPart, std::min(level.size(), (part + 1) * NodesPerPart));
+        });
+      }
+    }
+
+    void evaluate(std::vector<NodeBase*>& nodes, size_t first, size_t last)
+    {
+      for (size_t i = first; i < last; ++i)
+      {
+        try
+        {
+          nodes[i]->evaluate();
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lck(pSignal_->mtx);
+          if (!pError_)
+            pError_ = std::current_exception();
+        }
+      }
+    }
+
+    std::mutex graphMtx_;
+    std::unordered_map<const void*, NodeBase*> nodes_;
+    std::vector<RootBase*> roots_;
+    std::vector<std::unique_ptr<NodeBase>> owned_;
+    std::shared_ptr<Signal> pSignal_;
+    std::uint64_t waveId_ = 0;  // marks nodes scheduled by current wave
+    std::uint64_t waves_ = 0;   // waves that changed at least one root
+    std::exception_ptr pError_;
+    std::thread waveThread_;
+  };
+}
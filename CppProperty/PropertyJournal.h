@@ -0,0 +1,1139 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyJournal.h - Write-ahead journal of property mutations   //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package records each mutation of attached properties in an
+* append-only file, so their values can be rebuilt after a crash:
+* - PropertyJournal::enabled
+*     true only if PROPERTY_JOURNAL is defined.  Without it properties
+*     hold no journal pointer and their mutators generate no code for
+*     journaling.
+* - Set, PushBack, PushFront, PopBack, PopFront, Insert, InsertAt,
+*   InsertItem, Erase, EraseKey, Append, AppendRange, EditItem
+*     Changes made by Property.h's mutators.  Each encodes itself as
+*     a compact record, e.g., push_back records the new element, not
+*     the whole container.  Most are encoded before the value is
+*     modified, so a change that can't be recorded throws with the
+*     value untouched.  Mutations without a compact form, e.g.,
+*     modify(f), record the whole value afterward; if that record
+*     can't be made the journal fails, and sync() throws.
+* - Journal
+*     attach(id, prop) journals a property's mutations under id.
+*     sync() returns when every record written so far is on disk;
+*     concurrent callers share one fsync (group commit), and a
+*     background thread flushes every flushInterval regardless.
+*     checkpoint() snapshots attached properties and discards the
+*     records the snapshot covers.  recover() rebuilds attached
+*     properties from the last snapshot plus the journal tail.
+*     A journal opened on existing records refuses changes to
+*     attached properties, and checkpoints, until recover() has
+*     run, since records numbered from scratch would be skipped
+*     by later recoveries.
+*
+* Files are path.snap, the last checkpoint, and path.000001, ...,
+* the journal segments.  Each record is its length and checksum,
+* then property id, sequence number, operation, and arguments in the
+* SnapshotEncoding.h encoding.  Recovery stops at the first torn or
+* corrupt record, the tail of a write interrupted by a crash.
+*
+* Typical use:
+*   Journal journal("props");
+*   journal.attach(1, readings);  // before the properties are used
+*   journal.recover();            // restores readings, checkpoints
+*   readings.push_back(3.5);      // records one element
+*   journal.sync();               // durable when sync returns
+*
+* Writes through non-const operator[] or iterators aren't recorded,
+* use modify(f) or a WriteScope.  Attached properties must not be
+* destroyed while the journal checkpoints.  Failures throw
+* std::runtime_error.
+*
+* Required Files:
+* ---------------
+* PropertyJournal.h, SnapshotEncoding.h, Property.h,
+* CustomContTypeTraits.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - changes and checkpoints throw until recover() has run on a
+*   journal holding records, instead of being silently dropped
+*   by the next recovery
+* - records are encoded before the change they describe where
+*   possible; encode and commit replace append for mutators
+* - added InsertAt, InsertItem, and AppendRange; Erase now takes
+*   the erased range; removed Recorded
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "SnapshotEncoding.h"
+
+template<typename T, typename Lock> class PropertyBase;
+
+namespace PropertyJournal {
+
+#ifdef PROPERTY_JOURNAL
+  constexpr bool enabled = true;
+#else
+  constexpr bool enabled = false;
+#endif
+
+  enum class Op : std::uint8_t { Set, PushBack, PushFront, PopBack, PopFront, Insert, Erase, Append, EditItem };
+
+  using PropertySnapshot::Writer;
+  using PropertySnapshot::Reader;
+
+  namespace detail {
+
+    template<typename T, typename = void> struct has_push_back : std::false_type {};
+    template<typename T> struct has_push_back<T, std::void_t<decltype(
+      std::declval<T&>().push_back(std::declval<typename T::value_type>()))>> : std::true_type {};
+
+    template<typename T, typename = void> struct has_push_front : std::false_type {};
+    template<typename T> struct has_push_front<T, std::void_t<decltype(
+      std::declval<T&>().push_front(std::declval<typename T::value_type>()))>> : std::true_type {};
+
+    template<typename T, typename = void> struct has_pop_back : std::false_type {};
+    template<typename T> struct has_pop_back<T, std::void_t<decltype(std::declval<T&>().pop_back())>> : std::true_type {};
+
+    template<typename T, typename = void> struct has_pop_front : std::false_type {};
+    template<typename T> struct has_pop_front<T, std::void_t<decltype(std::declval<T&>().pop_front())>> : std::true_type {};
+
+    template<typename T, typename = void> struct has_insert : std::false_type {};
+    template<typename T> struct has_insert<T, std::void_t<decltype(
+      std::declval<T&>().insert(std::declval<T&>().begin(), std::declval<typename T::value_type>()))>> : std::true_type {};
+
+    template<typename T, typename = void> struct has_erase : std::false_type {};
+    template<typename T> struct has_erase<T, std::void_t<decltype(
+      std::declval<T&>().erase(std::declval<T&>().begin(), std::declval<T&>().begin()))>> : std::true_type {};
+
+    //----< multimaps' insert returns an iterator, not a pair >--
+
+    template<typename T>
+    constexpr bool isMulti()
+    {
+      return std::is_same<decltype(std::declval<T&>().insert(std::declval<const typename T::value_type&>())),
+        typename T::iterator>::value;
+    }
+    //----< position of it in t >----------------------------
+
+    template<typename T, typename It>
+    std::uint64_t indexOf(const T& t, It it)
+    {
+      return static_cast<std::uint64_t>(std::distance(t.begin(), typename T::const_iterator(it)));
+    }
+    //----< position of it among the items with its key >----
+
+    template<typename T, typename It>
+    std::uint64_t ordinalOf(const T& t, It it)
+    {
+      typename T::const_iterator pos(it);
+      return static_cast<std::uint64_t>(std::distance(t.equal_range(pos->first).first, pos));
+    }
+    //----< FNV-1a, detects torn and corrupt records >-------
+
+    inline std::uint32_t checksum(const char* p, size_t n)
+    {
+      std::uint32_t hash = 2166136261u;
+      for (size_t i = 0; i < n; ++i)
+      {
+        hash ^= static_cast<unsigned char>(p[i]);
+        hash *= 16777619u;
+      }
+      return hash;
+    }
+
+    inline std::FILE* openFile(const std::string& path, const char* mode)
+    {
+#ifdef _MSC_VER
+      std::FILE* pFile = nullptr;
+      if (fopen_s(&pFile, path.c_str(), mode) != 0)
+        return nullptr;
+      return pFile;
+#else
+      return std::fopen(path.c_str(), mode);
+#endif
+    }
+    //----< write and force to disk >------------------------
+
+    inline bool writeFile(std::FILE* pFile, const std::string& bytes)
+    {
+      if (std::fwrite(bytes.data(), 1, bytes.size(), pFile) != bytes.size() || std::fflush(pFile) != 0)
+        return false;
+#ifdef _WIN32
+      return _commit(_fileno(pFile)) == 0;
+#else
+      return ::fsync(fileno(pFile)) == 0;
+#endif
+    }
+    //----< make file creation and renaming durable >--------
+    /*
+    *  POSIX file systems may lose a new directory entry in a
+    *  crash unless the directory itself is synced.  NTFS logs
+    *  its metadata, so Windows needs nothing here.
+    */
+    inline void syncDirectory(const std::string& path)
+    {
+#ifndef _WIN32
+      std::string dir = std::filesystem::path(path).parent_path().string();
+      int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+      if (fd >= 0)
+      {
+        ::fsync(fd);
+        ::close(fd);
+      }
+#else
+      (void)path;
+#endif
+    }
+
+    inline bool readFile(const std::string& path, std::string& bytes)
+    {
+      std::ifstream in(path, std::ios::binary);
+      if (!in)
+        return false;
+      std::ostringstream contents;
+      contents << in.rdbuf();
+      bytes = contents.str();
+      return true;
+    }
+
+    template<typename T>
+    void readInto(Reader& in, T& t)
+    {
+      PropertySnapshot::readValue(in, t);
+    }
+
+    [[noreturn]] inline void mismatch()
+    {
+      throw std::runtime_error("exception: journal record doesn't fit property");
+    }
+    //----< replay one sequence container record >-----------
+
+    template<typename T>
+    void applySequence(T& t, Op op, Reader& in)
+    {
+      using value_type = typename T::value_type;
+      switch (op)
+      {
+      case Op::PushBack:
+        if constexpr (has_push_back<T>::value)
+        {
+          value_type v;
+          readInto(in, v);
+          t.push_back(std::move(v));
+          return;
+        }
+        break;
+      case Op::PushFront:
+        if constexpr (has_push_front<T>::value)
+        {
+          value_type v;
+          readInto(in, v);
+          t.push_front(std::move(v));
+          return;
+        }
+        break;
+      case Op::PopBack:
+        if constexpr (has_pop_back<T>::value)
+        {
+          t.pop_back();
+          return;
+        }
+        break;
+      case Op::PopFront:
+        if constexpr (has_pop_front<T>::value)
+        {
+          t.pop_front();
+          return;
+        }
+        break;
+      case Op::Insert:
+        if constexpr (has_insert<T>::value)
+        {
+          size_t index = static_cast<size_t>(in.readSize());
+          value_type v;
+          readInto(in, v);
+          t.insert(std::next(t.begin(), index), std::move(v));
+          return;
+        }
+        break;
+      case Op::Erase:
+        if constexpr (has_erase<T>::value)
+        {
+          size_t index = static_cast<size_t>(in.readSize());
+          size_t count = static_cast<size_t>(in.readSize());
+          auto first = std::next(t.begin(), index);
+          t.erase(first, std::next(first, count));
+          return;
+        }
+        break;
+      case Op::Append:
+        if constexpr (has_insert<T>::value)
+        {
+          size_t count = static_cast<size_t>(in.readSize());
+          for (size_t i = 0; i < count; ++i)
+          {
+            value_type v;
+            readInto(in, v);
+            t.insert(t.end(), std::move(v));
+          }
+          return;
+        }
+        break;
+      default:
+        break;
+      }
+      mismatch();
+    }
+    //----< replay one map record >--------------------------
+
+    template<typename T>
+    void applyMap(T& t, Op op, Reader& in)
+    {
+      typename T::key_type key;
+      typename T::mapped_type mapped;
+      switch (op)
+      {
+      case Op::Insert:
+        if constexpr (isMulti<T>())
+        {
+          size_t ordinal = static_cast<size_t>(in.readSize());
+          readInto(in, key);
+          readInto(in, mapped);
+          auto hint = std::next(t.equal_range(key).first, ordinal);
+          t.emplace_hint(hint, std::move(key), std::move(mapped));
+        }
+        else
+        {
+          readInto(in, key);
+          readInto(in, mapped);
+          t.emplace(std::move(key), std::move(mapped));
+        }
+        return;
+      case Op::Erase:
+        readInto(in, key);
+        if constexpr (isMulti<T>())
+        {
+          readInto(in, mapped);
+          auto range = t.equal_range(key);
+          for (auto iter = range.first; iter != range.second; ++iter)
+          {
+            if (iter->second == mapped)
+            {
+              t.erase(iter);
+              break;
+            }
+          }
+        }
+        else
+        {
+          t.erase(key);
+        }
+        return;
+      case Op::EditItem:
+      {
+        readInto(in, key);
+        readInto(in, mapped);
+        auto iter = t.find(key);
+        if (iter == t.end())
+          t.emplace(std::move(key), std::move(mapped));
+        else
+          iter->second = std::move(mapped);
+        return;
+      }
+      default:
+        break;
+      }
+      mismatch();
+    }
+    //----< replay one record onto t >-----------------------
+
+    template<typename T>
+    void apply(T& t, Op op, Reader& in)
+    {
+      if (op == Op::Set)
+        readInto(in, t);
+      else if constexpr (is_stl_assoc_container<T>::value)
+        applyMap(t, op, in);
+      else if constexpr (is_stl_seq_container<T>::value)
+        applySequence(t, op, in);
+      else
+        mismatch();
+    }
+  }
+
+  /////////////////////////////////////////////////////////////
+  // Changes
+  // - each names its operation and encodes its arguments given
+  //   the container it's passed
+  // - Set encodes the value it's passed, so mutators pass the
+  //   new value before assigning it, or the container after
+  //   a change with no compact form
+  // - Insert and Append read the container after the change,
+  //   for emplace and input ranges; the others read it before
+
+  struct Set
+  {
+    static constexpr Op op = Op::Set;
+    template<typename T>
+    void encode(Writer& out, const T& t) const
+    {
+      PropertySnapshot::writeValue(out, t);
+    }
+  };
+  //----< item about to be pushed, or just emplaced >------------
+
+  template<typename V>
+  struct PushBack
+  {
+    static constexpr Op op = Op::PushBack;
+    PushBack(const V& v) : value(v) {}
+
+    template<typename T>
+    void encode(Writer& out, const T&) const
+    {
+      PropertySnapshot::writeValue(out, static_cast<const typename T::value_type&>(value));
+    }
+    const V& value;
+  };
+
+  template<typename V>
+  struct PushFront
+  {
+    static constexpr Op op = Op::PushFront;
+    PushFront(const V& v) : value(v) {}
+
+    template<typename T>
+    void encode(Writer& out, const T&) const
+    {
+      PropertySnapshot::writeValue(out, static_cast<const typename T::value_type&>(value));
+    }
+    const V& value;
+  };
+
+  struct PopBack
+  {
+    static constexpr Op op = Op::PopBack;
+    template<typename T>
+    void encode(Writer&, const T&) const {}
+  };
+
+  struct PopFront
+  {
+    static constexpr Op op = Op::PopFront;
+    template<typename T>
+    void encode(Writer&, const T&) const {}
+  };
+  //----< item inserted at it, or by insert's pair result >------
+
+  template<typename It>
+  struct Insert
+  {
+    static constexpr Op op = Op::Insert;
+    Insert(It iter) : it(iter) {}
+    Insert(std::pair<It, bool> result) : it(result.first) {}
+
+    template<typename T>
+    void encode(Writer& out, const T& t) const
+    {
+      if constexpr (is_stl_assoc_container<T>::value)
+      {
+        if constexpr (detail::isMulti<T>())
+          out.writeSize(detail::ordinalOf(t, it));
+      }
+      else
+      {
+        out.writeSize(detail::indexOf(t, it));
+      }
+      PropertySnapshot::writeValue(out, *it);
+    }
+    It it;
+  };
+  //----< item about to be inserted before pos, sequences only >--
+
+  template<typename It, typename V>
+  struct InsertAt
+  {
+    static constexpr Op op = Op::Insert;
+    InsertAt(It position, const V& v) : pos(position), value(v) {}
+
+    template<typename T>
+    void encode(Writer& out, const T& t) const
+    {
+      out.writeSize(detail::indexOf(t, pos));
+      PropertySnapshot::writeValue(out, static_cast<const typename T::value_type&>(value));
+    }
+    It pos;
+    const V& value;
+  };
+  //----< item about to be inserted, without a hint, maps only >--
+  /*
+  *  Multimaps insert after the items with an equal key, so its
+  *  ordinal is their count.
+  */
+  template<typename V>
+  struct InsertItem
+  {
+    static constexpr Op op = Op::Insert;
+    InsertItem(const V& v) : value(v) {}
+
+    template<typename T>
+    void encode(Writer& out, const T& t) const
+    {
+      if constexpr (detail::isMulti<T>())
+        out.writeSize(static_cast<std::uint64_t>(t.count(value.first)));
+      PropertySnapshot::writeValue(out, value);
+    }
+    const V& value;
+  };
+  //----< items [first, last) about to be erased, sequences only >--
+
+  template<typename It>
+  struct Erase
+  {
+    static constexpr Op op = Op::Erase;
+    Erase(It firstIter, It lastIter) : first(firstIter), last(lastIter) {}
+
+    template<typename T>
+    void encode(Writer& out, const T& t) const
+    {
+      out.writeSize(detail::indexOf(t, first));
+      out.writeSize(static_cast<std::uint64_t>(std::distance(first, last)));
+    }
+    It first;
+    It last;
+  };
+  //----< map item about to be erased >--------------------------
+
+  template<typename It>
+  struct EraseKey
+  {
+    static constexpr Op op = Op::Erase;
+    EraseKey(It iter) : it(iter) {}
+
+    template<typename T>
+    void encode(Writer& out, const T&) const
+    {
+      PropertySnapshot::writeValue(out, it->first);
+      if constexpr (detail::isMulti<T>())
+        PropertySnapshot::writeValue(out, it->second);
+    }
+    It it;
+  };
+  //----< last count items of a sequence, just appended >--------
+
+  struct Append
+  {
+    static constexpr Op op = Op::Append;
+    Append(size_t appended) : count(appended) {}
+
+    template<typename T>
+    void encode(Writer& out, const T& t) const
+    {
+      out.writeSize(count);
+      for (auto iter = std::next(t.begin(), t.size() - count); iter != t.end(); ++iter)
+        PropertySnapshot::writeValue(out, static_cast<const typename T::value_type&>(*iter));
+    }
+    size_t count;
+  };
+  //----< forward range about to be appended >-------------------
+
+  template<typename It>
+  struct AppendRange
+  {
+    static constexpr Op op = Op::Append;
+    AppendRange(It firstIter, It lastIter) : first(firstIter), last(lastIter) {}
+
+    template<typename T>
+    void encode(Writer& out, const T&) const
+    {
+      out.writeSize(static_cast<std::uint64_t>(std::distance(first, last)));
+      for (It iter = first; iter != last; ++iter)
+        PropertySnapshot::writeValue(out, static_cast<const typename T::value_type&>(*iter));
+    }
+    It first;
+    It last;
+  };
+
+  template<typename K, typename M>
+  struct EditItem
+  {
+    static constexpr Op op = Op::EditItem;
+    EditItem(const K& k, const M& m) : key(k), mapped(m) {}
+
+    template<typename T>
+    void encode(Writer& out, const T&) const
+    {
+      PropertySnapshot::writeValue(out, key);
+      PropertySnapshot::writeValue(out, mapped);
+    }
+    const K& key;
+    const M& mapped;
+  };
+
+  class Journal;
+
+  /////////////////////////////////////////////////////////////
+  // Attachment struct
+  // - links an attached property to its journal
+  // - seq changes only while the property's lock is held, so a
+  //   snapshot taken under that lock pairs value and seq
+
+  struct Attachment
+  {
+    Journal* pJournal = nullptr;
+    std::uint32_t id = 0;
+    std::uint64_t seq = 0;
+    std::function<void(Writer&)> save;
+    std::function<void(Reader&)> restore;
+    std::function<void(Op, Reader&)> apply;
+    std::function<void()> unhook;
+  };
+
+  /////////////////////////////////////////////////////////////
+  // Journal class
+  // - writers encode records on their own threads, then append
+  //   them to a shared buffer under a short lock
+  // - the first syncing thread becomes the leader, writing and
+  //   syncing the whole buffer while later callers wait, so a
+  //   burst of writers shares each fsync
+  // - checkpoint first starts a new segment, then snapshots;
+  //   records in the new segment the snapshot already holds are
+  //   skipped by sequence number during recovery
+
+  class Journal
+  {
+  public:
+    static constexpr size_t FlushBytes = 1024 * 1024;
+
+    Journal(const std::string& path, std::chrono::milliseconds flushInterval = std::chrono::milliseconds(10))
+      : path_(path), interval_(flushInterval)
+    {
+      std::string image;
+      if (detail::readFile(snapshotPath(), image))
+      {
+        Reader in(image.data(), image.size());
+        std::uint64_t count;
+        firstSegment_ = readSnapshotHeader(in, count);
+      }
+      bool empty = image.empty();
+      segment_ = firstSegment_;
+      while (std::filesystem::exists(segmentPath(segment_)))
+      {
+        if (std::filesystem::file_size(segmentPath(segment_)) > SegmentHeaderSize)
+          empty = false;
+        ++segment_;
+      }
+      ready_.store(empty);
+      openSegment();
+      flusher_ = std::thread([this]() { flushLoop(); });
+    }
+
+    ~Journal()
+    {
+      {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stop_ = true;
+      }
+      flushCv_.notify_all();
+      flusher_.join();
+      {
+        std::lock_guard<std::mutex> attachLck(attachMtx_);
+        for (auto& item : attachments_)
+          item.second->unhook();
+      }
+      try
+      {
+        sync();
+      }
+      catch (...) {}
+      std::fclose(pFile_);
+    }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    //----< record prop's mutations under id >-----------------
+
+    template<typename T, typename Lock>
+    void attach(std::uint32_t id, PropertyBase<T, Lock>& prop)
+    {
+      static_assert(enabled || PropertySnapshot::detail::dependent_false<T>::value, "define PROPERTY_JOURNAL to journal properties");
+      static_assert(PropertySnapshot::isEncodable<T>(), "PropertyJournal doesn't support this type");
+      std::lock_guard<std::mutex> attachLck(attachMtx_);
+      if (attachments_.count(id) != 0)
+        throw std::runtime_error("exception: journal id is already attached");
+      std::unique_ptr<Attachment> pAttachment = std::make_unique<Attachment>();
+      Attachment* pAtt = pAttachment.get();
+      pAtt->pJournal = this;
+      pAtt->id = id;
+      pAtt->save = [&prop, pAtt](Writer& out) {
+        prop.read([&](const T& t) {
+          out.writeSize(pAtt->seq);
+          PropertySnapshot::writeValue(out, t);
+        });
+      };
+      pAtt->restore = [&prop, pAtt](Reader& in) {
+        std::uint64_t seq = in.readSize();
+        T t;
+        PropertySnapshot::readValue(in, t);
+        prop = std::move(t);
+        pAtt->seq = seq;
+      };
+      pAtt->apply = [&prop](Op op, Reader& in) {
+        prop.modify([&](T& t) { detail::apply(t, op, in); });
+      };
+      pAtt->unhook = [&prop]() {
+        prop.lock();
+        prop.pJournal_ = nullptr;
+        prop.unlock();
+      };
+      prop.lock();
+      prop.pJournal_ = pAtt;
+      prop.unlock();
+      attachments_[id] = std::move(pAttachment);
+    }
+    //----< called by an attached property's destructor >------
+
+    void detach(Attachment* pAtt)
+    {
+      std::lock_guard<std::mutex> attachLck(attachMtx_);
+      attachments_.erase(pAtt->id);
+    }
+    //----< throws if attached properties can't change yet >--
+
+    void admit() const
+    {
+      if (!ready_.load(std::memory_order_acquire) && !recovering_.load(std::memory_order_relaxed))
+        throw std::runtime_error("exception: journal holds records, call recover() before changing attached properties");
+    }
+    //----< encode change's record, before it's made >-----------
+    /*
+    *  Returns false, making no record, while recovering.  Throws
+    *  if the record can't be made, so the caller can abandon the
+    *  change.  The record is numbered by commit.
+    */
+    template<typename T, typename Change>
+    bool encode(Attachment& att, const T& t, const Change& change, std::string& record)
+    {
+      if (recovering_.load(std::memory_order_relaxed))
+        return false;
+      record.assign(RecordHeaderSize, '\0');
+      Writer out(record);
+      std::uint64_t seq = 0;
+      Op op = Change::op;
+      out.write(&att.id, sizeof(att.id));
+      out.write(&seq, sizeof(seq));
+      out.write(&op, sizeof(op));
+      change.encode(out, t);
+      if (record.size() - RecordHeaderSize > UINT32_MAX)
+        throw std::runtime_error("exception: journal record is too large");
+      return true;
+    }
+    //----< number and queue a record once its change is made >--
+    /*
+    *  Caller holds the property's lock, so its records are
+    *  numbered and appended in the order its changes were made.
+    *  The change can't be undone, so this doesn't throw: if the
+    *  record can't be queued the journal fails, and sync throws.
+    */
+    void commit(Attachment& att, std::string& record) noexcept
+    {
+      std::uint64_t seq = ++att.seq;
+      std::memcpy(&record[RecordHeaderSize + sizeof(att.id)], &seq, sizeof(seq));
+      std::uint32_t length = static_cast<std::uint32_t>(record.size() - RecordHeaderSize);
+      std::uint32_t sum = detail::checksum(record.data() + RecordHeaderSize, length);
+      std::memcpy(&record[0], &length, sizeof(length));
+      std::memcpy(&record[sizeof(length)], &sum, sizeof(sum));
+
+      std::lock_guard<std::mutex> lck(mtx_);
+      try
+      {
+        buffer_.append(record);
+      }
+      catch (...)
+      {
+        failed_ = true;
+        cv_.notify_all();
+        return;
+      }
+      ++appended_;
+      if (buffer_.size() >= FlushBytes)
+        flushCv_.notify_one();
+    }
+    //----< record a change already made, e.g., by modify(f) >--
+
+    template<typename T, typename Change>
+    void append(Attachment& att, const T& t, const Change& change) noexcept
+    {
+      std::string& record = scratch();
+      try
+      {
+        if (!encode(att, t, change, record))
+          return;
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lck(mtx_);
+        failed_ = true;
+        cv_.notify_all();
+        return;
+      }
+      commit(att, record);
+    }
+    //----< per thread record buffer, reused to avoid allocation >--
+
+    static std::string& scratch()
+    {
+      thread_local std::string record;
+      return record;
+    }
+    //----< return when all records appended so far are on disk >--
+
+    void sync()
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      std::uint64_t target = appended_;
+      for (;;)
+      {
+        if (failed_)
+          throw std::runtime_error("exception: journal write failed");
+        if (durable_ >= target)
+          return;
+        if (flushing_)
+          cv_.wait(lck);
+        else
+          flushLocked(lck);
+      }
+    }
+    //----< snapshot attached properties, drop covered segments >--
+
+    void checkpoint()
+    {
+      std::lock_guard<std::mutex> attachLck(attachMtx_);
+      admit();
+      checkpointLocked();
+    }
+    //----< restore attached properties, returns records replayed >--
+    /*
+    *  Call after attaching and before using the properties.
+    *  Until it's called on a journal holding records, changes
+    *  to attached properties throw.  Replayed changes aren't
+    *  journaled again; instead recover ends with a checkpoint.
+    */
+    size_t recover()
+    {
+      std::lock_guard<std::mutex> attachLck(attachMtx_);
+      recovering_.store(true);
+      size_t replayed = 0;
+      try
+      {
+        std::uint64_t segment = restoreSnapshot();
+        std::string image;
+        while (detail::readFile(segmentPath(segment), image))
+        {
+          bool complete = true;
+          replayed += replaySegment(image, complete);
+          if (!complete)
+            break;
+          ++segment;
+        }
+      }
+      catch (...)
+      {
+        recovering_.store(false);
+        throw;
+      }
+      recovering_.store(false);
+      checkpointLocked();
+      ready_.store(true);
+      return replayed;
+    }
+    //----< records appended, and fsyncs, since construction >-----
+
+    std::uint64_t records()
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      return appended_;
+    }
+
+    std::uint64_t syncs()
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      return syncs_;
+    }
+
+  private:
+    static constexpr size_t RecordHeaderSize = 2 * sizeof(std::uint32_t);
+    static constexpr char SegmentMagic[4] = { 'P', 'J', 'N', 'L' };
+    static constexpr char SnapshotMagic[4] = { 'P', 'J', 'S', 'N' };
+    static constexpr std::uint32_t FormatVersion = 1;
+    static constexpr size_t SegmentHeaderSize = sizeof(SegmentMagic) + sizeof(FormatVersion);
+
+    std::string segmentPath(std::uint64_t segment) const
+    {
+      std::ostringstream name;
+      name << path_ << "." << std::setw(6) << std::setfill('0') << segment;
+      return name.str();
+    }
+
+    std::string snapshotPath() const
+    {
+      return path_ + ".snap";
+    }
+
+    void openSegment()
+    {
+      std::string name = segmentPath(segment_);
+      pFile_ = detail::openFile(name, "wb");
+      if (pFile_ == nullptr)
+        throw std::runtime_error("exception: can't create journal segment " + name);
+      std::string header(SegmentMagic, sizeof(SegmentMagic));
+      header.append(reinterpret_cast<const char*>(&FormatVersion), sizeof(FormatVersion));
+      if (!detail::writeFile(pFile_, header))
+        throw std::runtime_error("exception: journal write failed");
+      detail::syncDirectory(name);
+    }
+    //----< leader writes the buffer, caller holds mtx_ >------
+
+    void flushLocked(std::unique_lock<std::mutex>& lck)
+    {
+      flushing_ = true;
+      std::string pending;
+      pending.swap(spare_);
+      pending.swap(buffer_);
+      std::uint64_t upto = appended_;
+      lck.unlock();
+      bool ok = detail::writeFile(pFile_, pending);
+      lck.lock();
+      pending.clear();
+      spare_.swap(pending);
+      flushing_ = false;
+      if (ok)
+      {
+        durable_ = upto;
+        ++syncs_;
+      }
+      else
+      {
+        failed_ = true;
+      }
+      cv_.notify_all();
+      if (!ok)
+        throw std::runtime_error("exception: journal write failed");
+    }
+    //----< bounds what a crash loses when nobody syncs >------
+
+    void flushLoop()
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      while (!stop_)
+      {
+        flushCv_.wait_for(lck, interval_);
+        if (!buffer_.empty() && !flushing_ && !failed_)
+        {
+          try
+          {
+            flushLocked(lck);
+          }
+          catch (...) {}  // reported by the next sync()
+        }
+      }
+    }
+    //----< flush this segment and start the next >-----------
+
+    std::uint64_t rotate()
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_.wait(lck, [this]() { return !flushing_; });
+      if (failed_ || !detail::writeFile(pFile_, buffer_))
+      {
+        failed_ = true;
+        throw std::runtime_error("exception: journal write failed");
+      }
+      buffer_.clear();
+      durable_ = appended_;
+      ++syncs_;
+      std::fclose(pFile_);
+      ++segment_;
+      openSegment();
+      return segment_;
+    }
+
+    void checkpointLocked()
+    {
+      std::uint64_t first = rotate();
+      std::string image;
+      Writer out(image);
+      out.write(SnapshotMagic, sizeof(SnapshotMagic));
+      out.write(&FormatVersion, sizeof(FormatVersion));
+      out.writeSize(first);
+      out.writeSize(attachments_.size());
+      for (auto& item : attachments_)
+      {
+        out.write(&item.first, sizeof(item.first));
+        size_t sizePos = image.size();
+        out.writeSize(0);
+        item.second->save(out);
+        std::uint64_t size = image.size() - sizePos - sizeof(std::uint64_t);
+        std::memcpy(&image[sizePos], &size, sizeof(size));
+      }
+
+      std::string temp = snapshotPath() + ".tmp";
+      std::FILE* pFile = detail::openFile(temp, "wb");
+      if (pFile == nullptr)
+        throw std::runtime_error("exception: can't create journal snapshot " + temp);
+      bool ok = detail::writeFile(pFile, image);
+      std::fclose(pFile);
+      if (!ok)
+        throw std::runtime_error("exception: journal snapshot write failed");
+      std::filesystem::rename(temp, snapshotPath());
+      detail::syncDirectory(snapshotPath());
+
+      std::error_code ec;
+      for (std::uint64_t segment = firstSegment_; segment < first; ++segment)
+        std::filesystem::remove(segmentPath(segment), ec);
+      firstSegment_ = first;
+    }
+
+    std::uint64_t readSnapshotHeader(Reader& in, std::uint64_t& count)
+    {
+      char magic[sizeof(SnapshotMagic)];
+      std::uint32_t version;
+      in.read(magic, sizeof(magic));
+      in.read(&version, sizeof(version));
+      if (std::memcmp(magic, SnapshotMagic, sizeof(magic)) != 0 || version != FormatVersion)
+        throw std::runtime_error("exception: not a journal snapshot, or unsupported version");
+      std::uint64_t first = in.readSize();
+      count = in.readSize();
+      return first;
+    }
+    //----< restore values, returns first segment to replay >--
+
+    std::uint64_t restoreSnapshot()
+    {
+      std::string image;
+      if (!detail::readFile(snapshotPath(), image))
+        return firstSegment_;
+      Reader in(image.data(), image.size());
+      std::uint64_t count;
+      std::uint64_t first = readSnapshotHeader(in, count);
+      for (std::uint64_t i = 0; i < count; ++i)
+      {
+        std::uint32_t id;
+        in.read(&id, sizeof(id));
+        size_t size = static_cast<size_t>(in.readSize());
+        if (size > in.remaining())
+          throw std::runtime_error("exception: journal snapshot is truncated");
+        const char* pPayload = image.data() + (image.size() - in.remaining());
+        auto iter = attachments_.find(id);
+        if (iter != attachments_.end())
+        {
+          Reader payload(pPayload, size);
+          iter->second->restore(payload);
+        }
+        in = Reader(pPayload + size, in.remaining() - size);
+      }
+      return first;
+    }
+    //----< apply records newer than each property's value >--
+
+    size_t replaySegment(const std::string& image, bool& complete)
+    {
+      if (image.size() < SegmentHeaderSize
+        || std::memcmp(image.data(), SegmentMagic, sizeof(SegmentMagic)) != 0)
+        throw std::runtime_error("exception: not a journal segment");
+      size_t replayed = 0;
+      size_t pos = SegmentHeaderSize;
+      complete = false;
+      while (pos < image.size())
+      {
+        std::uint32_t length, sum;
+        if (image.size() - pos < RecordHeaderSize)
+          return replayed;
+        std::memcpy(&length, image.data() + pos, sizeof(length));
+        std::memcpy(&sum, image.data() + pos + sizeof(length), sizeof(sum));
+        pos += RecordHeaderSize;
+        if (image.size() - pos < length || detail::checksum(image.data() + pos, length) != sum)
+          return replayed;
+        Reader in(image.data() + pos, length);
+        pos += length;
+        std::uint32_t id;
+        std::uint64_t seq;
+        Op op;
+        in.read(&id, sizeof(id));
+        in.read(&seq, sizeof(seq));
+        in.read(&op, sizeof(op));
+        auto iter = attachments_.find(id);
+        if (iter == attachments_.end() || seq <= iter->second->seq)
+          continue;
+        iter->second->apply(op, in);
+        iter->second->seq = seq;
+        ++replayed;
+      }
+      complete = true;
+      return replayed;
+    }
+
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::FILE* pFile_ = nullptr;
+    std::uint64_t firstSegment_ = 1;
+    std::uint64_t segment_ = 1;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable flushCv_;
+    std::string buffer_;
+    std::string spare_;
+    std::uint64_t appended_ = 0;
+    std::uint64_t durable_ = 0;
+    std::uint64_t syncs_ = 0;
+    bool flushing_ = false;
+    bool failed_ = false;
+    bool stop_ = false;
+    std::atomic<bool> recovering_ { false };
+    std::atomic<bool> ready_ { false };
+    std::thread flusher_;
+
+    std::mutex attachMtx_;
+    std::map<std::uint32_t, std::unique_ptr<Attachment>> attachments_;
+  };
+}
@@ -0,0 +1,292 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyNotifier.h - Change notification for properties         //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides the machinery behind PropertyBase<T>::subscribe:
+* - NotifierBase
+*     Interface the executor uses to run a pending notification
+* - NotifyExecutor
+*     Singleton owning one worker thread that runs notifications,
+*     so callbacks never run on the writer's thread
+* - ChangeNotifier<T>
+*     Holds a property's subscribers.  post() queues the notifier
+*     only if it isn't already queued, so a burst of writes is
+*     coalesced.  When the notifier runs it reads the property's
+*     current value once, through the source the property attached,
+*     and each subscriber sees only that latest value.  watch(cb)
+*     subscribes callbacks that take no value, and if only those
+*     are subscribed the value isn't read at all.
+*
+* A writer's cost is, at most, one queue insertion, independent of
+* the number of subscribers and of the size of the value.  Properties
+* that can't be read from another thread, e.g., Property<T>, post(t)
+* a copy of the value instead.
+*
+* Required Files:
+* ---------------
+* PropertyNotifier.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - post() no longer copies the value while the writer holds the
+*   property's lock; the executor reads it when dispatching
+* - added watch(cb)
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// NotifierBase class
+
+class NotifierBase
+{
+public:
+  virtual ~NotifierBase() {}
+  virtual void dispatch() = 0;
+};
+
+///////////////////////////////////////////////////////////////
+// NotifyExecutor class
+// - one worker keeps notifications for a given property in
+//   the order its writes were made
+// - the worker is joined when the program exits
+
+class NotifyExecutor
+{
+public:
+  static NotifyExecutor& instance()
+  {
+    static NotifyExecutor executor;
+    return executor;
+  }
+
+  void post(std::shared_ptr<NotifierBase> pNotifier)
+  {
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      pending_.push_back(std::move(pNotifier));
+    }
+    cv_.notify_one();
+  }
+
+private:
+  NotifyExecutor() : worker_([this]() { run(); }) {}
+  ~NotifyExecutor()
+  {
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();
+  }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    for (;;)
+    {
+      cv_.wait(lck, [this]() { return stop_ || !pending_.empty(); });
+      if (pending_.empty())
+        return;
+      std::shared_ptr<NotifierBase> pNotifier = std::move(pending_.front());
+      pending_.pop_front();
+      lck.unlock();
+      pNotifier->dispatch();
+      lck.lock();
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<std::shared_ptr<NotifierBase>> pending_;
+  bool stop_ = false;
+  std::thread worker_;
+};
+
+///////////////////////////////////////////////////////////////
+// ChangeNotifier<T> class
+// - subscriber list is copy-on-write, so dispatch calls the
+//   callbacks without holding the notifier's mutex, and they
+//   may subscribe or unsubscribe freely
+// - the source is called holding sourceMtx_, so detach() waits
+//   for a read in progress before the property is destroyed
+
+template<typename T>
+class ChangeNotifier : public NotifierBase, public std::enable_shared_from_this<ChangeNotifier<T>>
+{
+public:
+  using Callback = std::function<void(const T&)>;
+  using Signal = std::function<void()>;
+  using Source = std::function<std::shared_ptr<const T>()>;
+
+  size_t subscribe(Callback cb)
+  {
+    return add(std::move(cb), Signal());
+  }
+  //----< cb learns of writes without being passed the value >--
+
+  size_t watch(Signal cb)
+  {
+    return add(Callback(), std::move(cb));
+  }
+  //----< returns false if id isn't subscribed >-----------
+
+  bool unsubscribe(size_t id)
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    auto pNew = std::make_shared<Subscribers>();
+    for (auto& sub : *subscribers_)
+    {
+      if (sub.id != id)
+        pNew->push_back(sub);
+    }
+    bool found = pNew->size() != subscribers_->size();
+    subscribers_ = std::move(pNew);
+    updateCounts();
+    return found;
+  }
+  //----< property supplies its value through source >-----
+
+  void attach(Source source)
+  {
+    std::lock_guard<std::mutex> lck(sourceMtx_);
+    source_ = std::move(source);
+  }
+
+  void detach()
+  {
+    std::lock_guard<std::mutex> lck(sourceMtx_);
+    source_ = nullptr;
+  }
+  //----< queue dispatch if needed, value is read later >--
+
+  void post()
+  {
+    if (count_.load(std::memory_order_acquire) == 0)
+      return;
+    queue(nullptr);
+  }
+  //----< record a copy of t, for unattached properties >--
+
+  void post(const T& t)
+  {
+    if (count_.load(std::memory_order_acquire) == 0)
+      return;
+    std::shared_ptr<const T> pValue;
+    if (valueCount_.load(std::memory_order_acquire) > 0)
+      pValue = std::make_shared<const T>(t);
+    queue(std::move(pValue));
+  }
+
+  virtual void dispatch() override
+  {
+    std::shared_ptr<const T> pValue;
+    std::shared_ptr<const Subscribers> pSubs;
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      pValue.swap(pLatest_);
+      pSubs = subscribers_;
+      queued_ = false;
+    }
+    if (!pValue && wantsValue(*pSubs))
+    {
+      std::lock_guard<std::mutex> lck(sourceMtx_);
+      if (source_)
+        pValue = source_();
+    }
+    for (auto& sub : *pSubs)
+    {
+      if (sub.onSignal)
+        sub.onSignal();
+      else if (pValue)
+        sub.onValue(*pValue);
+    }
+  }
+
+private:
+  struct Subscriber
+  {
+    size_t id;
+    Callback onValue;
+    Signal onSignal;
+  };
+  using Subscribers = std::vector<Subscriber>;
+
+  size_t add(Callback onValue, Signal onSignal)
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    auto pNew = std::make_shared<Subscribers>(*subscribers_);
+    size_t id = ++lastId_;
+    pNew->push_back({ id, std::move(onValue), std::move(onSignal) });
+    subscribers_ = std::move(pNew);
+    updateCounts();
+    return id;
+  }
+
+  void updateCounts()
+  {
+    size_t values = 0;
+    for (auto& sub : *subscribers_)
+    {
+      if (sub.onValue)
+        ++values;
+    }
+    valueCount_.store(values, std::memory_order_release);
+    count_.store(subscribers_->size(), std::memory_order_release);
+  }
+
+  static bool wantsValue(const Subscribers& subs)
+  {
+    for (auto& sub : subs)
+    {
+      if (sub.onValue)
+        return true;
+    }
+    return false;
+  }
+
+  void queue(std::shared_ptr<const T> pValue)
+  {
+    bool wasQueued;
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      if (pValue)
+        pLatest_.swap(pValue);
+      wasQueued = queued_;
+      queued_ = true;
+    }
+    if (!wasQueued)
+      NotifyExecutor::instance().post(this->shared_from_this());
+  }
+
+  std::mutex mtx_;
+  std::shared_ptr<const Subscribers> subscribers_ = std::make_shared<const Subscribers>();
+  std::atomic<size_t> count_ { 0 };
+  std::atomic<size_t> valueCount_ { 0 };
+  std::shared_ptr<const T> pLatest_;
+  bool queued_ = false;
+  size_t lastId_ = 0;
+  std::mutex sourceMtx_;
+  Source source_;
+};
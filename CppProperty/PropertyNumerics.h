@@ -0,0 +1,552 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyNumerics.h - SIMD numeric operations on properties      //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides bulk numeric operations on properties holding
+* std::vector<E> for arithmetic E, e.g., TS_Property<std::vector<float>>:
+*   sum(prop), minimum(prop), maximum(prop), dot(prop, other)
+*     Reductions, run on the value in place under one shared lock
+*     acquisition, returning a scalar
+*   scale(prop, factor), clamp(prop, lo, hi)
+*     Modify every element in place under one lock acquisition,
+*     then notify subscribers once
+* The same operations are provided on raw arrays, e.g., sum(p, n).
+*
+* For float, double, and std::int32_t elements the loops use AVX2 when
+* the processor supports it, chosen once at run time.  Otherwise, and
+* for other element types, they use portable loops, which compilers
+* vectorize with SSE2 on x86-64.  Define PROPERTY_NO_SIMD to always
+* use the portable loops.
+*
+* - Signed integer sums and dot products accumulate in std::int64_t,
+*   unsigned ones in std::uint64_t.
+* - Floating point sums may differ from a sequential loop in the
+*   last bits, since AVX2 adds in a different order.
+* - minimum and maximum throw std::invalid_argument on empty values,
+*   and return NaN if any element is NaN.  clamp leaves NaN elements
+*   unchanged.  Both paths give the same results.
+*
+* Required Files:
+* ---------------
+* PropertyNumerics.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - unsigned sums accumulate in std::uint64_t
+* - minimum, maximum, and clamp treat NaN the same with and
+*   without AVX2
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Property.h"
+
+#if !defined(PROPERTY_NO_SIMD) && (defined(_M_X64) || defined(__x86_64__))
+#define PROPERTY_NUMERICS_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define PROPERTY_TARGET_AVX2
+#else
+#define PROPERTY_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace PropertyNumerics {
+
+  template<typename E>
+  using sum_type = std::conditional_t<
+    std::is_floating_point<E>::value, E,
+    std::conditional_t<std::is_unsigned<E>::value, std::uint64_t, std::int64_t>
+  >;
+
+  namespace detail {
+
+    //----< portable loops >---------------------------------
+
+    template<typename E>
+    sum_type<E> sumScalar(const E* p, size_t n)
+    {
+      sum_type<E> acc = 0;
+      for (size_t i = 0; i < n; ++i)
+        acc += p[i];
+      return acc;
+    }
+
+    template<typename E>
+    sum_type<E> dotScalar(const E* p, const E* q, size_t n)
+    {
+      sum_type<E> acc = 0;
+      for (size_t i = 0; i < n; ++i)
+        acc += static_cast<sum_type<E>>(p[i]) * q[i];
+      return acc;
+    }
+
+    template<typename E>
+    bool isNan(E e)
+    {
+      return e != e;
+    }
+    //----< any NaN element makes the result NaN >-----------
+
+    template<typename E>
+    E minimumScalar(const E* p, size_t n)
+    {
+      E result = p[0];
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (isNan(p[i]))
+          return std::numeric_limits<E>::quiet_NaN();
+        if (p[i] < result)
+          result = p[i];
+      }
+      return result;
+    }
+
+    template<typename E>
+    E maximumScalar(const E* p, size_t n)
+    {
+      E result = p[0];
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (isNan(p[i]))
+          return std::numeric_limits<E>::quiet_NaN();
+        if (result < p[i])
+          result = p[i];
+      }
+      return result;
+    }
+
+    template<typename E>
+    void scaleScalar(E* p, size_t n, E factor)
+    {
+      for (size_t i = 0; i < n; ++i)
+        p[i] *= factor;
+    }
+
+    //----< NaN elements compare false, so stay NaN >---------
+
+    template<typename E>
+    void clampScalar(E* p, size_t n, E lo, E hi)
+    {
+      for (size_t i = 0; i < n; ++i)
+        p[i] = std::min(std::max(p[i], lo), hi);
+    }
+
+    /////////////////////////////////////////////////////////////
+    // AVX2 kernels
+    // - each Avx2 traits struct wraps the intrinsics for one
+    //   element type, so one kernel template serves all three
+    // - everything calling intrinsics is compiled for AVX2 and
+    //   only reached after hasAvx2() returns true
+    // - min and max return their second operand if either is
+    //   NaN, so kernels pass the loaded elements second, and
+    //   floating point types report NaN lanes with unordered
+
+    template<typename E>
+    struct Avx2 { static constexpr bool available = false; };
+
+#ifdef PROPERTY_NUMERICS_AVX2
+
+    inline bool detectAvx2()
+    {
+#ifdef _MSC_VER
+      int info[4];
+      __cpuid(info, 0);
+      if (info[0] < 7)
+        return false;
+      __cpuid(info, 1);
+      bool osxsave = (info[2] & (1 << 27)) != 0;
+      bool avx = (info[2] & (1 << 28)) != 0;
+      if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+      __cpuidex(info, 7, 0);
+      return (info[1] & (1 << 5)) != 0;
+#else
+      return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+    template<>
+    struct Avx2<float>
+    {
+      static constexpr bool available = true;
+      static constexpr size_t width = 8;
+      using V = __m256;
+      PROPERTY_TARGET_AVX2 static V load(const float* p) { return _mm256_loadu_ps(p); }
+      PROPERTY_TARGET_AVX2 static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+      PROPERTY_TARGET_AVX2 static V set1(float e) { return _mm256_set1_ps(e); }
+      PROPERTY_TARGET_AVX2 static V add(V a, V b) { return _mm256_add_ps(a, b); }
+      PROPERTY_TARGET_AVX2 static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+      PROPERTY_TARGET_AVX2 static V min(V a, V b) { return _mm256_min_ps(a, b); }
+      PROPERTY_TARGET_AVX2 static V max(V a, V b) { return _mm256_max_ps(a, b); }
+      PROPERTY_TARGET_AVX2 static V unordered(V a, V b) { return _mm256_or_ps(a, _mm256_cmp_ps(b, b, _CMP_UNORD_Q)); }
+      PROPERTY_TARGET_AVX2 static bool any(V mask) { return _mm256_movemask_ps(mask) != 0; }
+    };
+
+    template<>
+    struct Avx2<double>
+    {
+      static constexpr bool available = true;
+      static constexpr size_t width = 4;
+      using V = __m256d;
+      PROPERTY_TARGET_AVX2 static V load(const double* p) { return _mm256_loadu_pd(p); }
+      PROPERTY_TARGET_AVX2 static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+      PROPERTY_TARGET_AVX2 static V set1(double e) { return _mm256_set1_pd(e); }
+      PROPERTY_TARGET_AVX2 static V add(V a, V b) { return _mm256_add_pd(a, b); }
+      PROPERTY_TARGET_AVX2 static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+      PROPERTY_TARGET_AVX2 static V min(V a, V b) { return _mm256_min_pd(a, b); }
+      PROPERTY_TARGET_AVX2 static V max(V a, V b) { return _mm256_max_pd(a, b); }
+      PROPERTY_TARGET_AVX2 static V unordered(V a, V b) { return _mm256_or_pd(a, _mm256_cmp_pd(b, b, _CMP_UNORD_Q)); }
+      PROPERTY_TARGET_AVX2 static bool any(V mask) { return _mm256_movemask_pd(mask) != 0; }
+    };
+
+    template<>
+    struct Avx2<std::int32_t>
+    {
+      static constexpr bool available = true;
+      static constexpr size_t width = 8;
+      using V = __m256i;
+      PROPERTY_TARGET_AVX2 static V load(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+      PROPERTY_TARGET_AVX2 static void store(std::int32_t* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+      PROPERTY_TARGET_AVX2 static V set1(std::int32_t e) { return _mm256_set1_epi32(e); }
+      PROPERTY_TARGET_AVX2 static V mul(V a, V b) { return _mm256_mullo_epi32(a, b); }
+      PROPERTY_TARGET_AVX2 static V min(V a, V b) { return _mm256_min_epi32(a, b); }
+      PROPERTY_TARGET_AVX2 static V max(V a, V b) { return _mm256_max_epi32(a, b); }
+
+      //----< widen to four 64 bit lanes each, for sums >------
+
+      PROPERTY_TARGET_AVX2 static __m256i lo64(V v) { return _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)); }
+      PROPERTY_TARGET_AVX2 static __m256i hi64(V v) { return _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)); }
+    };
+
+    //----< min or max, finishing with the scalar NaN rules >--
+
+    template<bool Min, typename E>
+    PROPERTY_TARGET_AVX2 E extremumAvx2(const E* p, size_t n)
+    {
+      using A = Avx2<E>;
+      if (n < A::width)
+        return Min ? minimumScalar(p, n) : maximumScalar(p, n);
+      typename A::V acc = A::load(p);
+      typename A::V nans = A::set1(0);
+      size_t i = 0;
+      for (; i + A::width <= n; i += A::width)
+      {
+        typename A::V v = A::load(p + i);
+        acc = Min ? A::min(acc, v) : A::max(acc, v);
+        if constexpr (std::is_floating_point<E>::value)
+          nans = A::unordered(nans, v);
+      }
+      if constexpr (std::is_floating_point<E>::value)
+      {
+        if (A::any(nans))
+          return std::numeric_limits<E>::quiet_NaN();
+      }
+      alignas(32) E lanes[2 * A::width];
+      A::store(lanes, acc);
+      size_t count = A::width;
+      for (; i < n; ++i)
+        lanes[count++] = p[i];
+      return Min ? minimumScalar(lanes, count) : maximumScalar(lanes, count);
+    }
+
+    template<typename E>
+    PROPERTY_TARGET_AVX2 E minimumAvx2(const E* p, size_t n)
+    {
+      return extremumAvx2<true>(p, n);
+    }
+
+    template<typename E>
+    PROPERTY_TARGET_AVX2 E maximumAvx2(const E* p, size_t n)
+    {
+      return extremumAvx2<false>(p, n);
+    }
+
+    template<typename E>
+    PROPERTY_TARGET_AVX2 void scaleAvx2(E* p, size_t n, E factor)
+    {
+      using A = Avx2<E>;
+      typename A::V f = A::set1(factor);
+      size_t i = 0;
+      for (; i + A::width <= n; i += A::width)
+        A::store(p + i, A::mul(A::load(p + i), f));
+      scaleScalar(p + i, n - i, factor);
+    }
+
+    template<typename E>
+    PROPERTY_TARGET_AVX2 void clampAvx2(E* p, size_t n, E lo, E hi)
+    {
+      using A = Avx2<E>;
+      typename A::V vlo = A::set1(lo);
+      typename A::V vhi = A::set1(hi);
+      size_t i = 0;
+      for (; i + A::width <= n; i += A::width)
+        A::store(p + i, A::min(vhi, A::max(vlo, A::load(p + i))));
+      clampScalar(p + i, n - i, lo, hi);
+    }
+    //----< floating point sums, two accumulators >----------
+
+    template<typename E>
+    PROPERTY_TARGET_AVX2 E sumAvx2(const E* p, size_t n)
+    {
+      using A = Avx2<E>;
+      typename A::V acc0 = A::set1(0);
+      typename A::V acc1 = A::set1(0);
+      size_t i = 0;
+      for (; i + 2 * A::width <= n; i += 2 * A::width)
+      {
+        acc0 = A::add(acc0, A::load(p + i));
+        acc1 = A::add(acc1, A::load(p + i + A::width));
+      }
+      alignas(32) E lanes[A::width];
+      A::store(lanes, A::add(acc0, acc1));
+      return sumScalar(lanes, A::width) + sumScalar(p + i, n - i);
+    }
+
+    template<typename E>
+    PROPERTY_TARGET_AVX2 E dotAvx2(const E* p, const E* q, size_t n)
+    {
+      using A = Avx2<E>;
+      typename A::V acc0 = A::set1(0);
+      typename A::V acc1 = A::set1(0);
+      size_t i = 0;
+      for (; i + 2 * A::width <= n; i += 2 * A::width)
+      {
+        acc0 = A::add(acc0, A::mul(A::load(p + i), A::load(q + i)));
+        acc1 = A::add(acc1, A::mul(A::load(p + i + A::width), A::load(q + i + A::width)));
+      }
+      alignas(32) E lanes[A::width];
+      A::store(lanes, A::add(acc0, acc1));
+      return sumScalar(lanes, A::width) + dotScalar(p + i, q + i, n - i);
+    }
+    //----< integer sums, widened to 64 bits >---------------
+
+    PROPERTY_TARGET_AVX2 inline std::int64_t sumAvx2Int(const std::int32_t* p, size_t n)
+    {
+      using A = Avx2<std::int32_t>;
+      __m256i acc = _mm256_setzero_si256();
+      size_t i = 0;
+      for (; i + A::width <= n; i += A::width)
+      {
+        A::V v = A::load(p + i);
+        acc = _mm256_add_epi64(acc, _mm256_add_epi64(A::lo64(v), A::hi64(v)));
+      }
+      alignas(32) std::int64_t lanes[4];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+      return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar(p + i, n - i);
+    }
+
+    PROPERTY_TARGET_AVX2 inline std::int64_t dotAvx2Int(const std::int32_t* p, const std::int32_t* q, size_t n)
+    {
+      using A = Avx2<std::int32_t>;
+      __m256i acc = _mm256_setzero_si256();
+      size_t i = 0;
+      for (; i + A::width <= n; i += A::width)
+      {
+        A::V a = A::load(p + i);
+        A::V b = A::load(q + i);
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(A::lo64(a), A::lo64(b)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(A::hi64(a), A::hi64(b)));
+      }
+      alignas(32) std::int64_t lanes[4];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+      return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dotScalar(p + i, q + i, n - i);
+    }
+
+#endif
+
+    inline bool hasAvx2()
+    {
+#ifdef PROPERTY_NUMERICS_AVX2
+      static const bool avx2 = detectAvx2();
+      return avx2;
+#else
+      return false;
+#endif
+    }
+
+    template<typename E>
+    constexpr bool useAvx2()
+    {
+      return Avx2<E>::available;
+    }
+  }
+
+  //----< name of the kernels chosen for this processor >------
+
+  inline const char* simdPath()
+  {
+    return detail::hasAvx2() ? "AVX2" : "portable";
+  }
+
+  /////////////////////////////////////////////////////////////
+  // operations on raw arrays
+
+  template<typename E>
+  sum_type<E> sum(const E* p, size_t n)
+  {
+    static_assert(std::is_arithmetic<E>::value, "sum requires arithmetic elements");
+#ifdef PROPERTY_NUMERICS_AVX2
+    if constexpr (detail::useAvx2<E>())
+    {
+      if (detail::hasAvx2())
+      {
+        if constexpr (std::is_integral<E>::value)
+          return detail::sumAvx2Int(p, n);
+        else
+          return detail::sumAvx2(p, n);
+      }
+    }
+#endif
+    return detail::sumScalar(p, n);
+  }
+
+  template<typename E>
+  sum_type<E> dot(const E* p, const E* q, size_t n)
+  {
+    static_assert(std::is_arithmetic<E>::value, "dot requires arithmetic elements");
+#ifdef PROPERTY_NUMERICS_AVX2
+    if constexpr (detail::useAvx2<E>())
+    {
+      if (detail::hasAvx2())
+      {
+        if constexpr (std::is_integral<E>::value)
+          return detail::dotAvx2Int(p, q, n);
+        else
+          return detail::dotAvx2(p, q, n);
+      }
+    }
+#endif
+    return detail::dotScalar(p, q, n);
+  }
+
+  template<typename E>
+  E minimum(const E* p, size_t n)
+  {
+    static_assert(std::is_arithmetic<E>::value, "minimum requires arithmetic elements");
+    if (n == 0)
+      throw std::invalid_argument("exception: minimum of empty range");
+#ifdef PROPERTY_NUMERICS_AVX2
+    if constexpr (detail::useAvx2<E>())
+    {
+      if (detail::hasAvx2())
+        return detail::minimumAvx2(p, n);
+    }
+#endif
+    return detail::minimumScalar(p, n);
+  }
+
+  template<typename E>
+  E maximum(const E* p, size_t n)
+  {
+    static_assert(std::is_arithmetic<E>::value, "maximum requires arithmetic elements");
+    if (n == 0)
+      throw std::invalid_argument("exception: maximum of empty range");
+#ifdef PROPERTY_NUMERICS_AVX2
+    if constexpr (detail::useAvx2<E>())
+    {
+      if (detail::hasAvx2())
+        return detail::maximumAvx2(p, n);
+    }
+#endif
+    return detail::maximumScalar(p, n);
+  }
+
+  template<typename E>
+  void scale(E* p, size_t n, E factor)
+  {
+    static_assert(std::is_arithmetic<E>::value, "scale requires arithmetic elements");
+#ifdef PROPERTY_NUMERICS_AVX2
+    if constexpr (detail::useAvx2<E>())
+    {
+      if (detail::hasAvx2())
+        return detail::scaleAvx2(p, n, factor);
+    }
+#endif
+    detail::scaleScalar(p, n, factor);
+  }
+
+  template<typename E>
+  void clamp(E* p, size_t n, E lo, E hi)
+  {
+    static_assert(std::is_arithmetic<E>::value, "clamp requires arithmetic elements");
+#ifdef PROPERTY_NUMERICS_AVX2
+    if constexpr (detail::useAvx2<E>())
+    {
+      if (detail::hasAvx2())
+        return detail::clampAvx2(p, n, lo, hi);
+    }
+#endif
+    detail::clampScalar(p, n, lo, hi);
+  }
+
+  /////////////////////////////////////////////////////////////
+  // operations on properties
+  // - accept Property, TS_Property, RW_Property, etc., holding
+  //   std::vector<E>
+  // - reductions hold a shared lock, scale and clamp an
+  //   exclusive lock, for the whole operation
+
+  template<typename E, typename Lock>
+  sum_type<E> sum(PropertyBase<std::vector<E>, Lock>& prop)
+  {
+    return prop.read([](const std::vector<E>& v) { return sum(v.data(), v.size()); });
+  }
+  //----< dot product of prop's value with other >-------------
+  /*
+  *  Takes a vector rather than a second property, since locking
+  *  two properties in either order could deadlock.  Throws
+  *  std::invalid_argument if the sizes differ.
+  */
+  template<typename E, typename Lock>
+  sum_type<E> dot(PropertyBase<std::vector<E>, Lock>& prop, const std::vector<E>& other)
+  {
+    return prop.read([&other](const std::vector<E>& v) {
+      if (v.size() != other.size())
+        throw std::invalid_argument("exception: dot of vectors with different sizes");
+      return dot(v.data(), other.data(), v.size());
+    });
+  }
+
+  template<typename E, typename Lock>
+  E minimum(PropertyBase<std::vector<E>, Lock>& prop)
+  {
+    return prop.read([](const std::vector<E>& v) { return minimum(v.data(), v.size()); });
+  }
+
+  template<typename E, typename Lock>
+  E maximum(PropertyBase<std::vector<E>, Lock>& prop)
+  {
+    return prop.read([](const std::vector<E>& v) { return maximum(v.data(), v.size()); });
+  }
+
+  template<typename E, typename Lock>
+  void scale(PropertyBase<std::vector<E>, Lock>& prop, E factor)
+  {
+    prop.modify([factor](std::vector<E>& v) { scale(v.data(), v.size(), factor); });
+  }
+
+  template<typename E, typename Lock>
+  void clamp(PropertyBase<std::vector<E>, Lock>& prop, E lo, E hi)
+  {
+    prop.modify([lo, hi](std::vector<E>& v) { clamp(v.data(), v.size(), lo, hi); });
+  }
+}
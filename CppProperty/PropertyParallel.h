@@ -0,0 +1,353 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyParallel.h - Parallel algorithms over properties        //
+// ver 1.2 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package runs algorithms over the elements of a property holding
+* a random access sequence container, e.g., TS_Property<std::vector<T>>,
+* splitting the elements into contiguous parts processed concurrently:
+* - for_each(prop, f), transform(prop, f), sort(prop, comp)
+*     Modify elements in place holding the property's lock once,
+*     then notify subscribers once
+* - reduce(prop, init, op), count_if(prop, pred)
+*     Read elements holding the property's lock once, shared for
+*     RW_Property, and return a scalar
+* - WorkerPool
+*     Singleton owning one worker thread per additional hardware
+*     thread.  parallel_for(parts, f) calls f(part) for each part,
+*     on the workers and the calling thread, and returns when all
+*     have finished, rethrowing the first exception thrown.
+*     setConcurrency(n) limits the threads running parts to n,
+*     adding workers if there are fewer, e.g., to measure scaling.
+*
+* The functions passed in, f, op, pred, and comp, must not use the
+* property they're applied to.  They run on worker threads while the
+* calling thread holds the property's lock, so a call back into the
+* property deadlocks.  TS_Property's lock is recursive, so the same
+* code works on small values, run on the calling thread alone, and
+* hangs once a value is split, above MinPartSize elements.
+*
+* Values smaller than MinPartSize elements per part are processed on
+* the calling thread alone.  std::execution::par isn't used because
+* not every standard library supports it without extra libraries.
+*
+* Required Files:
+* ---------------
+* PropertyParallel.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 17 Oct 2026
+* - added WorkerPool::setConcurrency
+* ver 1.1 : 17 Oct 2026
+* - documented that functions passed in must not use the property
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Property.h"
+
+namespace PropertyParallel {
+
+  constexpr size_t MinPartSize = 16 * 1024;
+
+  /////////////////////////////////////////////////////////////
+  // WorkerPool class
+  // - a job's parts are claimed with an atomic counter, so fast
+  //   threads take more parts and the caller never waits idle
+  //   while parts remain
+  // - a part may itself call parallel_for; its caller claims
+  //   parts too, so that can't deadlock
+
+  class WorkerPool
+  {
+  public:
+    static WorkerPool& instance()
+    {
+      static WorkerPool pool;
+      return pool;
+    }
+    //----< number of threads that may run parts at once >--
+
+    size_t concurrency() const
+    {
+      return limit_.load(std::memory_order_relaxed);
+    }
+    //----< let at most threads run parts at once >----------
+    /*
+    *  Defaults to hardware_concurrency().  Workers are added if
+    *  there are too few, and never removed; those above the
+    *  limit stay idle.  A limit above the number of cores
+    *  oversubscribes them, useful only for measuring.
+    */
+    void setConcurrency(size_t threads)
+    {
+      threads = std::max<size_t>(1, threads);
+      std::lock_guard<std::mutex> lck(mtx_);
+      while (workers_.size() + 1 < threads)
+        workers_.push_back(std::thread([this]() { work(); }));
+      limit_.store(threads, std::memory_order_relaxed);
+    }
+
+    void parallel_for(size_t parts, std::function<void(size_t)> f)
+    {
+      if (parts == 0)
+        return;
+      std::shared_ptr<Job> pJob = std::make_shared<Job>(parts, std::move(f));
+      size_t helpers = std::min(parts - 1, concurrency() - 1);
+      if (helpers > 0)
+      {
+        {
+          std::lock_guard<std::mutex> lck(mtx_);
+          for (size_t i = 0; i < helpers; ++i)
+            pending_.push_back(pJob);
+        }
+        if (helpers == 1)
+          cv_.notify_one();
+        else
+          cv_.notify_all();
+      }
+      pJob->run();
+      std::unique_lock<std::mutex> lck(pJob->mtx);
+      pJob->cv.wait(lck, [&]() { return pJob->done == pJob->parts; });
+      if (pJob->pError)
+        std::rethrow_exception(pJob->pError);
+    }
+
+  private:
+    struct Job
+    {
+      Job(size_t n, std::function<void(size_t)> fn) : parts(n), f(std::move(fn)) {}
+
+      //----< claim and run parts until none remain >--------
+
+      void run()
+      {
+        size_t part;
+        while ((part = next.fetch_add(1, std::memory_order_relaxed)) < parts)
+        {
+          try
+          {
+            f(part);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lck(mtx);
+            if (!pError)
+              pError = std::current_exception();
+          }
+          std::lock_guard<std::mutex> lck(mtx);
+          if (++done == parts)
+            cv.notify_one();
+        }
+      }
+
+      const size_t parts;
+      std::function<void(size_t)> f;
+      std::atomic<size_t> next { 0 };
+      size_t done = 0;
+      std::exception_ptr pError;
+      std::mutex mtx;
+      std::condition_variable cv;
+    };
+
+    WorkerPool()
+    {
+      unsigned hw = std::thread::hardware_concurrency();
+      size_t count = (hw > 1) ? hw - 1 : 0;
+      for (size_t i = 0; i < count; ++i)
+        workers_.push_back(std::thread([this]() { work(); }));
+      limit_.store(count + 1, std::memory_order_relaxed);
+    }
+    ~WorkerPool()
+    {
+      {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stop_ = true;
+      }
+      cv_.notify_all();
+      for (auto& worker : workers_)
+        worker.join();
+    }
+
+    void work()
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      for (;;)
+      {
+        cv_.wait(lck, [this]() { return stop_ || !pending_.empty(); });
+        if (pending_.empty())
+          return;
+        std::shared_ptr<Job> pJob = std::move(pending_.front());
+        pending_.pop_front();
+        lck.unlock();
+        pJob->run();
+        lck.lock();
+      }
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<Job>> pending_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> limit_ { 1 };
+  };
+
+  namespace detail {
+
+    template<typename T>
+    using iterator_category = typename std::iterator_traits<typename T::iterator>::iterator_category;
+
+    template<typename T>
+    constexpr bool isRandomAccess()
+    {
+      return std::is_base_of<std::random_access_iterator_tag, iterator_category<T>>::value;
+    }
+    //----< number of parts to split n elements into >-------
+
+    inline size_t partCount(size_t n)
+    {
+      size_t parts = n / MinPartSize;
+      size_t threads = WorkerPool::instance().concurrency();
+      return std::max<size_t>(1, std::min(parts, threads));
+    }
+    //----< call f(part, first, last) on each part of [begin, begin + n) >--
+
+    template<typename It, typename F>
+    void forEachPart(It begin, size_t n, size_t parts, F f)
+    {
+      if (parts == 1)
+      {
+        f(0, begin, begin + n);
+        return;
+      }
+      WorkerPool::instance().parallel_for(parts, [&](size_t part) {
+        It first = begin + (n * part / parts);
+        It last = begin + (n * (part + 1) / parts);
+        f(part, first, last);
+      });
+    }
+  }
+
+  //----< call f(element&) on every element >--------------------
+  /*
+  *  f runs on worker threads while this thread holds prop's
+  *  lock, so it must not use prop, see Package Operations.
+  */
+
+  template<typename T, typename Lock, typename F>
+  void for_each(PropertyBase<T, Lock>& prop, F f)
+  {
+    static_assert(detail::isRandomAccess<T>(), "parallel for_each needs random access iterators");
+    prop.modify([&f](T& t) {
+      detail::forEachPart(t.begin(), t.size(), detail::partCount(t.size()),
+        [&f](size_t, typename T::iterator first, typename T::iterator last) { std::for_each(first, last, f); });
+    });
+  }
+  //----< replace every element with f(element) >---------------
+
+  template<typename T, typename Lock, typename F>
+  void transform(PropertyBase<T, Lock>& prop, F f)
+  {
+    static_assert(detail::isRandomAccess<T>(), "parallel transform needs random access iterators");
+    prop.modify([&f](T& t) {
+      detail::forEachPart(t.begin(), t.size(), detail::partCount(t.size()),
+        [&f](size_t, typename T::iterator first, typename T::iterator last) { std::transform(first, last, first, f); });
+    });
+  }
+  //----< combine elements with op, which must be associative >--
+  /*
+  *  Each part is folded separately, then the parts' results are
+  *  folded onto init in order, so op needn't be commutative.
+  */
+  template<typename T, typename Lock, typename R, typename Op>
+  R reduce(PropertyBase<T, Lock>& prop, R init, Op op)
+  {
+    static_assert(detail::isRandomAccess<T>(), "parallel reduce needs random access iterators");
+    return prop.read([&](const T& t) {
+      size_t n = t.size();
+      if (n == 0)
+        return init;
+      size_t parts = detail::partCount(n);
+      std::vector<R> partials(parts);
+      detail::forEachPart(t.begin(), n, parts,
+        [&](size_t part, typename T::const_iterator first, typename T::const_iterator last) {
+          R acc = *first;
+          for (++first; first != last; ++first)
+            acc = op(acc, *first);
+          partials[part] = acc;
+        });
+      R result = init;
+      for (auto& partial : partials)
+        result = op(result, partial);
+      return result;
+    });
+  }
+
+  template<typename T, typename Lock, typename Pred>
+  size_t count_if(PropertyBase<T, Lock>& prop, Pred pred)
+  {
+    static_assert(detail::isRandomAccess<T>(), "parallel count_if needs random access iterators");
+    return prop.read([&pred](const T& t) {
+      std::atomic<size_t> count { 0 };
+      detail::forEachPart(t.begin(), t.size(), detail::partCount(t.size()),
+        [&](size_t, typename T::const_iterator first, typename T::const_iterator last) {
+          count.fetch_add(static_cast<size_t>(std::count_if(first, last, pred)), std::memory_order_relaxed);
+        });
+      return count.load();
+    });
+  }
+  //----< sort parts concurrently, then merge pairs of parts >---
+  /*
+  *  Not stable.  Merging takes log2(parts) rounds, each round
+  *  merging its pairs concurrently.
+  */
+  template<typename T, typename Lock, typename Compare = std::less<>>
+  void sort(PropertyBase<T, Lock>& prop, Compare comp = Compare())
+  {
+    static_assert(detail::isRandomAccess<T>(), "parallel sort needs random access iterators");
+    prop.modify([&comp](T& t) {
+      size_t n = t.size();
+      size_t parts = detail::partCount(n);
+      auto begin = t.begin();
+      auto bound = [&](size_t part) { return begin + (n * part / parts); };
+      detail::forEachPart(begin, n, parts,
+        [&comp](size_t, typename T::iterator first, typename T::iterator last) { std::sort(first, last, comp); });
+      for (size_t width = 1; width < parts; width *= 2)
+      {
+        size_t merges = (parts + 2 * width - 1) / (2 * width);
+        auto mergePair = [&](size_t merge) {
+          size_t lo = merge * 2 * width;
+          size_t mid = std::min(lo + width, parts);
+          size_t hi = std::min(lo + 2 * width, parts);
+          if (mid < hi)
+            std::inplace_merge(bound(lo), bound(mid), bound(hi), comp);
+        };
+        if (merges == 1)
+          mergePair(0);
+        else
+          WorkerPool::instance().parallel_for(merges, mergePair);
+      }
+    });
+  }
+}
@@ -0,0 +1,206 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertySnapshot.h - Binary snapshot and restore of properties  //
+// ver 1.2 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package saves property values to, and restores them from, a
+* compact binary format:
+* - save(out, prop), load(in, prop)
+*     Snapshot and restore one property, e.g., a TS_Property<T>
+* - PropertyGroup
+*     add(name, prop) registers a property; save(out) writes every
+*     registered property, and load(in) restores each one it finds
+*     by name, skipping unknown names, and returns the count restored.
+*     A record that doesn't decode to exactly its recorded size,
+*     e.g., after a registered property's type changed, throws
+*     rather than misreading the records after it
+* - Writer, Reader, writeValue(writer, t), readValue(reader, t)
+*     The value encoding, for building other formats, defined in
+*     SnapshotEncoding.h with the list of supported values
+*
+* Values are written in the machine's own byte order and sizes, so
+* a snapshot is for restoring by the same build on the same kind of
+* machine, e.g., after a restart.  PropertyGroup::save needs a
+* seekable stream, e.g., std::ofstream opened in binary mode.
+* Each property is read under its own lock, so a group snapshot is
+* not atomic across properties.  Failures throw std::runtime_error.
+*
+* Required Files:
+* ---------------
+* PropertySnapshot.h, SnapshotEncoding.h, Property.h,
+* CustomContTypeTraits.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 17 Oct 2026
+* - PropertyGroup::load reads each record through a Reader limited
+*   to the record's size, and throws if a property's value doesn't
+*   fill its record exactly
+* ver 1.1 : 17 Oct 2026
+* - moved the value encoding to SnapshotEncoding.h
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "SnapshotEncoding.h"
+#include "Property.h"
+
+namespace PropertySnapshot {
+
+  constexpr char Magic[4] = { 'P', 'S', 'N', 'P' };
+  constexpr std::uint32_t FormatVersion = 1;
+
+  namespace detail {
+
+    inline void writeHeader(Writer& out)
+    {
+      out.write(Magic, sizeof(Magic));
+      std::uint32_t version = FormatVersion;
+      out.write(&version, sizeof(version));
+    }
+
+    inline void readHeader(Reader& in)
+    {
+      char magic[sizeof(Magic)];
+      std::uint32_t version;
+      in.read(magic, sizeof(magic));
+      in.read(&version, sizeof(version));
+      if (std::memcmp(magic, Magic, sizeof(Magic)) != 0 || version != FormatVersion)
+        throw std::runtime_error("exception: not a property snapshot, or unsupported version");
+    }
+  }
+
+  //----< write one property's value, read under its lock >------
+
+  template<typename T, typename Lock>
+  void save(std::ostream& out, PropertyBase<T, Lock>& prop)
+  {
+    Writer writer(out);
+    detail::writeHeader(writer);
+    prop.read([&writer](const T& t) { writeValue(writer, t); });
+  }
+  //----< replace one property's value, notifying subscribers >--
+  /*
+  *  Reads into a new value first, so a failed restore leaves the
+  *  property unchanged and holds its lock only to move the value.
+  */
+  template<typename T, typename Lock>
+  void load(std::istream& in, PropertyBase<T, Lock>& prop)
+  {
+    Reader reader(in);
+    detail::readHeader(reader);
+    T t;
+    readValue(reader, t);
+    prop = std::move(t);
+  }
+
+  /////////////////////////////////////////////////////////////
+  // PropertyGroup class
+  // - each record is the name, the payload size, then the
+  //   value, so load can skip records it doesn't know, and
+  //   can check that each value it decodes fills its record
+  // - registered properties must outlive the group
+
+  class PropertyGroup
+  {
+  public:
+    template<typename T, typename Lock>
+    void add(const std::string& name, PropertyBase<T, Lock>& prop)
+    {
+      Entry entry;
+      entry.name = name;
+      entry.save = [&prop](Writer& out) {
+        prop.read([&out](const T& t) { writeValue(out, t); });
+      };
+      entry.load = [&prop, name](Reader& in) {
+        T t;
+        readValue(in, t);
+        if (in.remaining() != 0)
+          throw std::runtime_error("exception: snapshot record \"" + name + "\" doesn't match its property's type");
+        prop = std::move(t);
+      };
+      entries_.push_back(std::move(entry));
+    }
+
+    void save(std::ostream& out)
+    {
+      Writer writer(out);
+      detail::writeHeader(writer);
+      writer.writeSize(entries_.size());
+      for (auto& entry : entries_)
+      {
+        writeValue(writer, entry.name);
+        std::streampos sizePos = out.tellp();
+        writer.writeSize(0);
+        entry.save(writer);
+        std::streampos endPos = out.tellp();
+        if (sizePos == std::streampos(-1) || endPos == std::streampos(-1))
+          throw std::runtime_error("exception: PropertyGroup::save needs a seekable stream");
+        out.seekp(sizePos);
+        writer.writeSize(static_cast<std::uint64_t>(endPos - sizePos) - sizeof(std::uint64_t));
+        out.seekp(endPos);
+      }
+      out.flush();
+    }
+    //----< restore registered properties found in the snapshot >--
+
+    size_t load(std::istream& in)
+    {
+      Reader reader(in);
+      detail::readHeader(reader);
+      size_t records = static_cast<size_t>(reader.readSize());
+      size_t restored = 0;
+      for (size_t i = 0; i < records; ++i)
+      {
+        std::string name;
+        readValue(reader, name);
+        std::uint64_t payload = reader.readSize();
+        Entry* pEntry = find(name);
+        if (pEntry == nullptr)
+        {
+          reader.skip(static_cast<size_t>(payload));
+          continue;
+        }
+        Reader record = reader.section(static_cast<size_t>(payload));
+        pEntry->load(record);
+        ++restored;
+      }
+      return restored;
+    }
+
+  private:
+    struct Entry
+    {
+      std::string name;
+      std::function<void(Writer&)> save;
+      std::function<void(Reader&)> load;
+    };
+
+    Entry* find(const std::string& name)
+    {
+      for (auto& entry : entries_)
+      {
+        if (entry.name == name)
+          return &entry;
+      }
+      return nullptr;
+    }
+
+    std::vector<Entry> entries_;
+  };
+}
@@ -0,0 +1,222 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyTable.h - Columnar storage for properties of many items //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* PropertyTable<Ts...> holds the properties of a large population of
+* entities.  Each entity is a row and each Ts is a column.  Every
+* column is stored contiguously, struct-of-arrays style, so a pass
+* over one property of a million entities reads only that property.
+* - addRow(values...)
+*     Appends an entity, returning its row number
+* - at<Col>(row)
+*     Returns a Handle<Col>, a two word reference to one cell with
+*     the familiar property interface, operator()() and operator=(t)
+* - for_each<Col>(f), for_each_row<Col>(f), reduce<Col>(init, f),
+*   count_if<Col>(pred), find_if<Col>(pred)
+*     Column scans that touch only column Col
+* - column<Col>()
+*     Gives read access to a whole column, e.g., for std algorithms
+*
+* Columns can't be bool, since std::vector<bool> hands out proxies
+* rather than bool&; use std::uint8_t for flags.
+*
+* Like Property<T>, a PropertyTable does no locking, so it is for use
+* by a single thread, or by threads that synchronize themselves.
+*
+* Required Files:
+* ---------------
+* PropertyTable.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - bool columns are rejected at compile time
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// PropertyTable<Ts...> class
+// - rows are never moved or removed individually, so a row
+//   number, and a Handle holding one, stays valid as rows are
+//   added; references into a column do not
+
+template<typename... Ts>
+class PropertyTable
+{
+public:
+  static constexpr size_t columnCount = sizeof...(Ts);
+
+  template<size_t Col>
+  using column_type = std::tuple_element_t<Col, std::tuple<Ts...>>;
+
+  /////////////////////////////////////////////////////////////
+  // Handle<Col> class
+  // - refers to the cell at (row, Col)
+
+  template<size_t Col>
+  class Handle
+  {
+  public:
+    using T = column_type<Col>;
+
+    Handle(PropertyTable& table, size_t row) : pTable_(&table), row_(row) {}
+
+    T operator()() const
+    {
+      return pTable_->template column<Col>()[row_];
+    }
+    void operator()(const T& t)
+    {
+      pTable_->template columnRef<Col>()[row_] = t;
+    }
+    Handle& operator=(const T& t)
+    {
+      pTable_->template columnRef<Col>()[row_] = t;
+      return *this;
+    }
+    Handle& operator=(T&& t)
+    {
+      pTable_->template columnRef<Col>()[row_] = std::move(t);
+      return *this;
+    }
+    //----< call f(T&) on cell, return its result >----------
+
+    template<typename F>
+    auto modify(F f)
+    {
+      return f(pTable_->template columnRef<Col>()[row_]);
+    }
+
+    size_t row() const { return row_; }
+
+  private:
+    PropertyTable* pTable_;
+    size_t row_;
+  };
+
+  //----< append entity, returning its row number >----------
+
+  size_t addRow(const Ts&... values)
+  {
+    return addRow(std::index_sequence_for<Ts...>(), values...);
+  }
+
+  size_t addRow()
+  {
+    return addRow(Ts()...);
+  }
+
+  void reserve(size_t rows)
+  {
+    reserve(std::index_sequence_for<Ts...>(), rows);
+  }
+
+  size_t rows() const
+  {
+    return std::get<0>(columns_).size();
+  }
+
+  template<size_t Col>
+  Handle<Col> at(size_t row)
+  {
+    return Handle<Col>(*this, row);
+  }
+
+  template<size_t Col>
+  const std::vector<column_type<Col>>& column() const
+  {
+    return std::get<Col>(columns_);
+  }
+  //----< call f(T&) on every cell of column Col >-----------
+
+  template<size_t Col, typename F>
+  void for_each(F f)
+  {
+    for (auto&& value : columnRef<Col>())
+      f(value);
+  }
+  //----< call f(row, T&) on every cell of column Col >------
+
+  template<size_t Col, typename F>
+  void for_each_row(F f)
+  {
+    std::vector<column_type<Col>>& col = columnRef<Col>();
+    for (size_t row = 0; row < col.size(); ++row)
+      f(row, col[row]);
+  }
+  //----< fold column Col with f(acc, value) >---------------
+
+  template<size_t Col, typename R, typename F>
+  R reduce(R init, F f) const
+  {
+    for (auto&& value : column<Col>())
+      init = f(init, value);
+    return init;
+  }
+
+  template<size_t Col, typename Pred>
+  size_t count_if(Pred pred) const
+  {
+    size_t count = 0;
+    for (auto&& value : column<Col>())
+    {
+      if (pred(value))
+        ++count;
+    }
+    return count;
+  }
+  //----< returns first matching row, or rows() if none >----
+
+  template<size_t Col, typename Pred>
+  size_t find_if(Pred pred) const
+  {
+    const std::vector<column_type<Col>>& col = column<Col>();
+    for (size_t row = 0; row < col.size(); ++row)
+    {
+      if (pred(col[row]))
+        return row;
+    }
+    return col.size();
+  }
+
+private:
+  static_assert(sizeof...(Ts) > 0, "PropertyTable needs at least one column");
+  static_assert(!(std::is_same<Ts, bool>::value || ...), "PropertyTable columns can't be bool, use std::uint8_t");
+
+  template<size_t Col>
+  std::vector<column_type<Col>>& columnRef()
+  {
+    return std::get<Col>(columns_);
+  }
+
+  template<size_t... Cols>
+  size_t addRow(std::index_sequence<Cols...>, const Ts&... values)
+  {
+    (std::get<Cols>(columns_).push_back(values), ...);
+    return rows() - 1;
+  }
+
+  template<size_t... Cols>
+  void reserve(std::index_sequence<Cols...>, size_t rows)
+  {
+    (std::get<Cols>(columns_).reserve(rows), ...);
+  }
+
+  std::tuple<std::vector<Ts>...> columns_;
+};
@@ -0,0 +1,247 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PropertyTrace.h - Low overhead tracing of property operations   //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package records property operations, e.g., set, get, lock,
+* without doing console I/O on the calling thread:
+* - PropertyTrace::enabled
+*     true only if PROPERTY_TRACE is defined.  Callers test it with
+*     if constexpr, so with tracing off no code is generated.
+* - PropertyTrace::Record
+*     Compact binary record: timestamp, property id, thread, and op
+* - PropertyTrace::TraceSink
+*     Singleton.  record(pProp, op) writes a Record into the calling
+*     thread's SPSC ring buffer, never blocking; if the ring is full
+*     the record is dropped and counted.  A background thread drains
+*     every ring, formats the records, and writes them to an output
+*     stream, std::cout unless changed with output(out).  flush()
+*     drains synchronously.  A thread's ring is discarded once the
+*     thread has exited and its records have been drained.
+*
+* Required Files:
+* ---------------
+* PropertyTrace.h, RingBufferProperty.h, Property.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - rings of exited threads are discarded after their last drain,
+*   so thread churn doesn't grow the sink
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "RingBufferProperty.h"
+
+namespace PropertyTrace {
+
+#ifdef PROPERTY_TRACE
+  constexpr bool enabled = true;
+#else
+  constexpr bool enabled = false;
+#endif
+
+  enum class Op : std::uint8_t { Lock, Unlock, LockShared, UnlockShared, Set, Get };
+
+  inline const char* opName(Op op)
+  {
+    switch (op)
+    {
+    case Op::Lock: return "lock";
+    case Op::Unlock: return "unlock";
+    case Op::LockShared: return "lock_shared";
+    case Op::UnlockShared: return "unlock_shared";
+    case Op::Set: return "set";
+    case Op::Get: return "get";
+    }
+    return "?";
+  }
+
+  struct Record
+  {
+    std::uint64_t timeNs;
+    std::uintptr_t propertyId;
+    std::uint32_t thread;
+    Op op;
+  };
+
+  /////////////////////////////////////////////////////////////
+  // TraceSink class
+  // - each thread's buffer is shared with the sink, so records
+  //   written just before a thread exits are still drained
+  // - a thread's BufferOwner marks its buffer retired on exit;
+  //   the drainer drops a retired buffer once it is empty
+  // - the drainer runs only after the first record is written
+
+  class TraceSink
+  {
+  public:
+    static constexpr size_t RingSize = 4096;
+
+    static TraceSink& instance()
+    {
+      static TraceSink sink;
+      return sink;
+    }
+
+    void record(const void* pProp, Op op)
+    {
+      ThreadBuffer& buffer = localBuffer();
+      Record rec {
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count()),
+        reinterpret_cast<std::uintptr_t>(pProp),
+        buffer.thread,
+        op
+      };
+      if (!buffer.ring.try_push(rec))
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    //----< set stream the drainer writes to >---------------
+
+    void output(std::ostream& out)
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      pOut_ = &out;
+    }
+    //----< drain and format all pending records now >-------
+
+    void flush()
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      drainLocked();
+      pOut_->flush();
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ThreadBuffer
+    {
+      SPSC_RingProperty<Record, RingSize> ring;
+      std::atomic<std::uint64_t> dropped { 0 };
+      std::uint64_t reported = 0;
+      std::uint32_t thread = 0;
+      std::atomic<bool> retired { false };
+    };
+
+    struct BufferOwner
+    {
+      ~BufferOwner()
+      {
+        pBuffer->retired.store(true, std::memory_order_release);
+      }
+      std::shared_ptr<ThreadBuffer> pBuffer;
+    };
+
+    TraceSink() : start_(Clock::now()) {}
+    ~TraceSink()
+    {
+      {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stop_ = true;
+      }
+      cv_.notify_one();
+      if (drainer_.joinable())
+        drainer_.join();
+      flush();
+    }
+
+    ThreadBuffer& localBuffer()
+    {
+      thread_local BufferOwner owner { addBuffer() };
+      return *owner.pBuffer;
+    }
+
+    std::shared_ptr<ThreadBuffer> addBuffer()
+    {
+      std::shared_ptr<ThreadBuffer> pBuffer = std::make_shared<ThreadBuffer>();
+      std::lock_guard<std::mutex> lck(mtx_);
+      pBuffer->thread = nextThread_++;
+      buffers_.push_back(pBuffer);
+      if (!drainer_.joinable())
+        drainer_ = std::thread([this]() { drain(); });
+      return pBuffer;
+    }
+
+    void drain()
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      while (!stop_)
+      {
+        cv_.wait_for(lck, std::chrono::milliseconds(10));
+        drainLocked();
+      }
+    }
+
+    //----< format records, then write them to output >-----
+    /*
+    *  Formatting into a local stream leaves the output stream's
+    *  flags alone, since other threads may be writing to it.
+    *  retired is read before draining, so a retired buffer's
+    *  last records are drained before it is dropped.
+    */
+    void drainLocked()
+    {
+      Record recs[64];
+      size_t kept = 0;
+      for (size_t b = 0; b < buffers_.size(); ++b)
+      {
+        std::shared_ptr<ThreadBuffer>& pBuffer = buffers_[b];
+        bool retired = pBuffer->retired.load(std::memory_order_acquire);
+        std::ostringstream formatted;
+        size_t n;
+        while ((n = pBuffer->ring.try_pop_n(recs, 64)) != 0)
+        {
+          for (size_t i = 0; i < n; ++i)
+          {
+            formatted << "\n  [" << std::setw(12) << recs[i].timeNs << " ns] thread " << recs[i].thread
+              << " property 0x" << std::hex << recs[i].propertyId << std::dec
+              << " " << opName(recs[i].op);
+          }
+        }
+        std::uint64_t dropped = pBuffer->dropped.load(std::memory_order_relaxed);
+        if (dropped != pBuffer->reported)
+        {
+          formatted << "\n  thread " << pBuffer->thread << " dropped " << dropped - pBuffer->reported << " records";
+          pBuffer->reported = dropped;
+        }
+        *pOut_ << formatted.str();
+        if (retired)
+          continue;
+        if (kept != b)
+          buffers_[kept] = std::move(pBuffer);
+        ++kept;
+      }
+      buffers_.resize(kept);
+    }
+
+    Clock::time_point start_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    std::uint32_t nextThread_ = 0;
+    std::ostream* pOut_ = &std::cout;
+    bool stop_ = false;
+    std::thread drainer_;
+  };
+}
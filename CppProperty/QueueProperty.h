@@ -0,0 +1,251 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// QueueProperty.h - Blocking producer/consumer queue property     //
+// ver 1.0 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a thread-safe work queue property:
+* - QueueProperty<T>
+*     Holds a std::deque<T>.  Consumers can block until an item
+*     arrives with wait_pop() or wait_pop_for(timeout), poll with
+*     try_pop(), or drain up to n items under one lock with pop_n(n).
+*     Producers push one item or a batch.  If constructed with a
+*     capacity, push blocks while the queue is full and try_push
+*     fails, giving producers backpressure.
+*     close() wakes all waiters; after that pushes fail and pops
+*     return whatever remains, then nothing.
+*
+* Each push wakes at most as many consumers as it added items, and
+* only when some consumer is waiting, so there's no thundering herd.
+*
+* Required Files:
+* ---------------
+* QueueProperty.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////
+// QueueProperty<T> class
+// - capacity of zero means unbounded
+
+template<typename T>
+class QueueProperty
+{
+public:
+  using value_type = T;
+
+  QueueProperty(size_t capacity = 0) : capacity_(capacity) {}
+
+  QueueProperty(const QueueProperty<T>& prop) = delete;
+  QueueProperty<T>& operator=(const QueueProperty<T>& prop) = delete;
+
+  //----< wait for room, then enqueue; false if closed >---
+
+  bool push(const T& t)
+  {
+    T copy(t);
+    return push(std::move(copy));
+  }
+
+  bool push(T&& t)
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    waitForRoom(lck, 1);
+    if (closed_)
+      return false;
+    items_.push_back(std::move(t));
+    lck.unlock();
+    wakeConsumers(1);
+    return true;
+  }
+  //----< enqueue only if there's room now >---------------
+
+  bool try_push(const T& t)
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    if (closed_ || isFull(1))
+      return false;
+    items_.push_back(t);
+    lck.unlock();
+    wakeConsumers(1);
+    return true;
+  }
+  //----< enqueue a batch, waiting for room as needed >----
+  /*
+  *  With a capacity, a batch larger than the free space is added
+  *  in pieces, so consumers can drain while the rest waits.
+  *  Returns number of items pushed, less than the batch size
+  *  only if the queue was closed.
+  */
+  template<typename InputIt>
+  size_t push_n(InputIt first, InputIt last)
+  {
+    size_t pushed = 0;
+    while (first != last)
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      waitForRoom(lck, 1);
+      if (closed_)
+        break;
+      size_t added = 0;
+      while (first != last && !isFull(1))
+      {
+        items_.push_back(*first);
+        ++first;
+        ++added;
+      }
+      lck.unlock();
+      wakeConsumers(added);
+      pushed += added;
+    }
+    return pushed;
+  }
+  //----< wait for an item; empty only if closed >---------
+
+  std::optional<T> wait_pop()
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    ++waitingConsumers_;
+    notEmpty_.wait(lck, [this]() { return !items_.empty() || closed_; });
+    --waitingConsumers_;
+    return popLocked(lck);
+  }
+  //----< wait up to timeout for an item >-----------------
+
+  template<typename Rep, typename Period>
+  std::optional<T> wait_pop_for(const std::chrono::duration<Rep, Period>& timeout)
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    ++waitingConsumers_;
+    notEmpty_.wait_for(lck, timeout, [this]() { return !items_.empty() || closed_; });
+    --waitingConsumers_;
+    return popLocked(lck);
+  }
+
+  std::optional<T> try_pop()
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    return popLocked(lck);
+  }
+  //----< remove up to n items under one lock >------------
+
+  std::vector<T> pop_n(size_t n)
+  {
+    std::vector<T> popped;
+    std::unique_lock<std::mutex> lck(mtx_);
+    size_t count = (n < items_.size()) ? n : items_.size();
+    popped.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      popped.push_back(std::move(items_.front()));
+      items_.pop_front();
+    }
+    lck.unlock();
+    wakeProducers(count);
+    return popped;
+  }
+
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      closed_ = true;
+    }
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  bool closed() const
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    return closed_;
+  }
+
+  size_t size() const
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    return items_.size();
+  }
+
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+private:
+  bool isFull(size_t n) const
+  {
+    return capacity_ != 0 && items_.size() + n > capacity_;
+  }
+
+  void waitForRoom(std::unique_lock<std::mutex>& lck, size_t n)
+  {
+    if (capacity_ == 0)
+      return;
+    ++waitingProducers_;
+    notFull_.wait(lck, [this, n]() { return !isFull(n) || closed_; });
+    --waitingProducers_;
+  }
+
+  std::optional<T> popLocked(std::unique_lock<std::mutex>& lck)
+  {
+    if (items_.empty())
+      return std::nullopt;
+    std::optional<T> item(std::move(items_.front()));
+    items_.pop_front();
+    lck.unlock();
+    wakeProducers(1);
+    return item;
+  }
+  //----< wake one waiter per item, only if anyone waits >--
+  /*
+  *  The waiter counts are read without the lock.  A stale zero
+  *  is harmless: a waiter increments its count under the lock
+  *  before checking the predicate, so it either sees the new
+  *  item or is counted before this notify.
+  */
+  void wakeConsumers(size_t added)
+  {
+    if (added == 0 || waitingConsumers_ == 0)
+      return;
+    for (size_t i = 0; i < added; ++i)
+      notEmpty_.notify_one();
+  }
+
+  void wakeProducers(size_t removed)
+  {
+    if (capacity_ == 0 || removed == 0 || waitingProducers_ == 0)
+      return;
+    for (size_t i = 0; i < removed; ++i)
+      notFull_.notify_one();
+  }
+
+  mutable std::mutex mtx_;
+  std::condition_variable notEmpty_;
+  std::condition_variable notFull_;
+  std::deque<T> items_;
+  size_t capacity_;
+  bool closed_ = false;
+  std::atomic<size_t> waitingConsumers_ { 0 };
+  std::atomic<size_t> waitingProducers_ { 0 };
+};
@@ -0,0 +1,311 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// RingBufferProperty.h - Lock-free bounded ring buffer properties //
+// ver 1.0 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides fixed capacity, lock-free queues for handing
+* items between threads with low latency:
+* - SPSC_RingProperty<T, Capacity>
+*     For exactly one producer thread and one consumer thread.
+*     Each side keeps a private copy of the other side's index and
+*     only rereads the shared one when the copy says full or empty.
+* - MPMC_RingProperty<T, Capacity>
+*     For any number of producers and consumers.  Each slot carries
+*     a sequence number that tells producers and consumers whose turn
+*     it is, after Dmitry Vyukov's bounded MPMC queue:
+*     https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+*
+* Both provide try_push, try_pop, try_push_n, try_pop_n, size_approx,
+* and capacity.  None of these ever block or take a lock.  Capacity
+* must be a power of two.  Head and tail indices sit on separate
+* cache lines, as do the slots of the MPMC ring, so producers and
+* consumers don't falsely share.
+*
+* Required Files:
+* ---------------
+* RingBufferProperty.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace RingBuffer {
+
+  constexpr size_t CacheLine = 64;
+
+  constexpr bool isPowerOfTwo(size_t n)
+  {
+    return n != 0 && (n & (n - 1)) == 0;
+  }
+}
+
+///////////////////////////////////////////////////////////////
+// SPSC_RingProperty<T, Capacity> class
+// - only one thread may push, and only one thread may pop
+
+template<typename T, size_t Capacity>
+class SPSC_RingProperty
+{
+  static_assert(RingBuffer::isPowerOfTwo(Capacity), "SPSC_RingProperty capacity must be a power of two");
+public:
+  using value_type = T;
+
+  SPSC_RingProperty() : slots_(new T[Capacity]) {}
+
+  SPSC_RingProperty(const SPSC_RingProperty&) = delete;
+  SPSC_RingProperty& operator=(const SPSC_RingProperty&) = delete;
+
+  //----< producer side >----------------------------------
+
+  bool try_push(const T& t)
+  {
+    T copy(t);
+    return try_push(std::move(copy));
+  }
+
+  bool try_push(T&& t)
+  {
+    size_t tail = prod_.tail.load(std::memory_order_relaxed);
+    if (tail - prod_.cachedHead == Capacity)
+    {
+      prod_.cachedHead = cons_.head.load(std::memory_order_acquire);
+      if (tail - prod_.cachedHead == Capacity)
+        return false;
+    }
+    slots_[tail & Mask] = std::move(t);
+    prod_.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  //----< push up to n items, publishing them once >-------
+  /*
+  *  Returns number pushed, fewer than n if the ring fills.
+  */
+  template<typename InputIt>
+  size_t try_push_n(InputIt first, size_t n)
+  {
+    size_t tail = prod_.tail.load(std::memory_order_relaxed);
+    size_t room = Capacity - (tail - prod_.cachedHead);
+    if (room < n)
+    {
+      prod_.cachedHead = cons_.head.load(std::memory_order_acquire);
+      room = Capacity - (tail - prod_.cachedHead);
+    }
+    size_t count = (n < room) ? n : room;
+    for (size_t i = 0; i < count; ++i, ++first)
+      slots_[(tail + i) & Mask] = *first;
+    prod_.tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+  //----< consumer side >----------------------------------
+
+  bool try_pop(T& t)
+  {
+    size_t head = cons_.head.load(std::memory_order_relaxed);
+    if (head == cons_.cachedTail)
+    {
+      cons_.cachedTail = prod_.tail.load(std::memory_order_acquire);
+      if (head == cons_.cachedTail)
+        return false;
+    }
+    t = std::move(slots_[head & Mask]);
+    cons_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+  //----< pop up to n items, releasing their slots once >--
+
+  template<typename OutputIt>
+  size_t try_pop_n(OutputIt out, size_t n)
+  {
+    size_t head = cons_.head.load(std::memory_order_relaxed);
+    size_t avail = cons_.cachedTail - head;
+    if (avail < n)
+    {
+      cons_.cachedTail = prod_.tail.load(std::memory_order_acquire);
+      avail = cons_.cachedTail - head;
+    }
+    size_t count = (n < avail) ? n : avail;
+    for (size_t i = 0; i < count; ++i, ++out)
+      *out = std::move(slots_[(head + i) & Mask]);
+    cons_.head.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  size_t size_approx() const
+  {
+    size_t tail = prod_.tail.load(std::memory_order_acquire);
+    size_t head = cons_.head.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  static constexpr size_t Mask = Capacity - 1;
+
+  struct alignas(RingBuffer::CacheLine) ProducerSide
+  {
+    std::atomic<size_t> tail { 0 };
+    size_t cachedHead = 0;
+  };
+  struct alignas(RingBuffer::CacheLine) ConsumerSide
+  {
+    std::atomic<size_t> head { 0 };
+    size_t cachedTail = 0;
+  };
+
+  ProducerSide prod_;
+  ConsumerSide cons_;
+  std::unique_ptr<T[]> slots_;
+};
+
+///////////////////////////////////////////////////////////////
+// MPMC_RingProperty<T, Capacity> class
+// - a slot whose sequence equals the tail index is free for the
+//   producer claiming that index; a slot whose sequence equals
+//   head index + 1 holds an item for the consumer claiming that
+//   index
+
+template<typename T, size_t Capacity>
+class MPMC_RingProperty
+{
+  static_assert(RingBuffer::isPowerOfTwo(Capacity) && Capacity >= 2,
+    "MPMC_RingProperty capacity must be a power of two, at least 2");
+public:
+  using value_type = T;
+
+  MPMC_RingProperty() : slots_(new Slot[Capacity])
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  MPMC_RingProperty(const MPMC_RingProperty&) = delete;
+  MPMC_RingProperty& operator=(const MPMC_RingProperty&) = delete;
+
+  bool try_push(const T& t)
+  {
+    T copy(t);
+    return try_push(std::move(copy));
+  }
+
+  bool try_push(T&& t)
+  {
+    size_t pos = tail_.value.load(std::memory_order_relaxed);
+    Slot* pSlot;
+    for (;;)
+    {
+      pSlot = &slots_[pos & Mask];
+      size_t seq = pSlot->seq.load(std::memory_order_acquire);
+      std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0)
+      {
+        if (tail_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;  // full
+      else
+        pos = tail_.value.load(std::memory_order_relaxed);
+    }
+    pSlot->value = std::move(t);
+    pSlot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& t)
+  {
+    size_t pos = head_.value.load(std::memory_order_relaxed);
+    Slot* pSlot;
+    for (;;)
+    {
+      pSlot = &slots_[pos & Mask];
+      size_t seq = pSlot->seq.load(std::memory_order_acquire);
+      std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0)
+      {
+        if (head_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+        return false;  // empty
+      else
+        pos = head_.value.load(std::memory_order_relaxed);
+    }
+    t = std::move(pSlot->value);
+    pSlot->seq.store(pos + Capacity, std::memory_order_release);
+    return true;
+  }
+  //----< push up to n items, stopping when full >---------
+  /*
+  *  Other producers may interleave, so the batch isn't
+  *  guaranteed to occupy adjacent slots.
+  */
+  template<typename InputIt>
+  size_t try_push_n(InputIt first, size_t n)
+  {
+    size_t count = 0;
+    for (; count < n; ++count, ++first)
+    {
+      if (!try_push(*first))
+        break;
+    }
+    return count;
+  }
+
+  template<typename OutputIt>
+  size_t try_pop_n(OutputIt out, size_t n)
+  {
+    size_t count = 0;
+    T t;
+    for (; count < n; ++count, ++out)
+    {
+      if (!try_pop(t))
+        break;
+      *out = std::move(t);
+    }
+    return count;
+  }
+
+  size_t size_approx() const
+  {
+    size_t tail = tail_.value.load(std::memory_order_acquire);
+    size_t head = head_.value.load(std::memory_order_acquire);
+    return (tail > head) ? tail - head : 0;
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  static constexpr size_t Mask = Capacity - 1;
+
+  struct alignas(RingBuffer::CacheLine) Slot
+  {
+    std::atomic<size_t> seq;
+    T value;
+  };
+  struct alignas(RingBuffer::CacheLine) Index
+  {
+    std::atomic<size_t> value { 0 };
+  };
+
+  Index tail_;
+  Index head_;
+  std::unique_ptr<Slot[]> slots_;
+};
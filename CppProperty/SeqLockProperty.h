@@ -0,0 +1,148 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// SeqLockProperty.h - Seqlock property for small POD structs      //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a thread-safe property for trivially copyable
+* values, read much more often than written:
+* - SeqLockProperty<T>
+*     Readers copy the value, then check a sequence counter, and retry
+*     if a write happened during the copy.  Readers never write to
+*     the property, so they don't invalidate each other's cache
+*     lines, and they never wait for a lock.  The writer never waits
+*     for readers.
+*     Provides operator=(t), operator()(t), operator()(), load(),
+*     store(t), and version().
+*
+* The value is held as an array of atomic words, copied with relaxed
+* loads and stores, so concurrent reads and writes are not data races.
+*
+* Required Files:
+* ---------------
+* SeqLockProperty.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - added version()
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////
+// SeqLockProperty<T> class
+// - the sequence count is odd while a write is in progress
+// - intended for a single writer; concurrent writers are
+//   serialized with a spin flag that a lone writer always
+//   finds clear
+// - aligned to a cache line so neighboring data doesn't
+//   share the line readers poll
+
+template<typename T>
+class alignas(64) SeqLockProperty
+{
+  static_assert(std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value,
+    "SeqLockProperty<T> requires a trivially copyable, default constructible T");
+public:
+  using value_type = T;
+
+  SeqLockProperty()
+  {
+    write(T());
+  }
+  SeqLockProperty(const T& t)
+  {
+    write(t);
+  }
+
+  SeqLockProperty(const SeqLockProperty<T>& prop) = delete;
+  SeqLockProperty<T>& operator=(const SeqLockProperty<T>& prop) = delete;
+
+  SeqLockProperty<T>& operator=(const T& t)
+  {
+    store(t);
+    return *this;
+  }
+  void operator()(const T& t)
+  {
+    store(t);
+  }
+  T operator()() const
+  {
+    return load();
+  }
+  //----< copy value, retrying if a write overlapped >-----
+
+  T load() const
+  {
+    Word buffer[NumWords];
+    size_t seq1, seq2;
+    do {
+      seq1 = seq_.load(std::memory_order_acquire);
+      while (seq1 & 1)
+      {
+        std::this_thread::yield();
+        seq1 = seq_.load(std::memory_order_acquire);
+      }
+      for (size_t i = 0; i < NumWords; ++i)
+        buffer[i] = words_[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      seq2 = seq_.load(std::memory_order_relaxed);
+    } while (seq1 != seq2);
+
+    T t;
+    std::memcpy(&t, buffer, sizeof(T));
+    return t;
+  }
+  //----< publish new value >------------------------------
+
+  void store(const T& t)
+  {
+    while (writing_.test_and_set(std::memory_order_acquire))
+      std::this_thread::yield();
+    write(t);
+    writing_.clear(std::memory_order_release);
+  }
+
+  //----< completed writes, the constructor's included >---
+
+  std::uint64_t version() const
+  {
+    return seq_.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  using Word = std::uintptr_t;
+  static constexpr size_t NumWords = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+  void write(const T& t)
+  {
+    Word buffer[NumWords] = {};
+    std::memcpy(buffer, &t, sizeof(T));
+
+    size_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < NumWords; ++i)
+      words_[i].store(buffer[i], std::memory_order_relaxed);
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  std::atomic<size_t> seq_ { 0 };
+  std::atomic<Word> words_[NumWords];
+  std::atomic_flag writing_ = ATOMIC_FLAG_INIT;
+};
@@ -0,0 +1,224 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// ShardedProperty.h - Associative property with per-shard locks   //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a thread-safe associative property that
+* scales with the number of threads using it:
+* - ShardedProperty<T, N>
+*     Splits the items of an STL associative container T across N
+*     shards, chosen by hashing the key with T's hasher, or with
+*     std::hash for ordered containers.  Each shard has its own lock,
+*     so threads working on different keys rarely contend.
+*     Provides insert, find, contains, erase, editItem, operator[],
+*     size, for_each, and operator()().  Whole-map operations visit
+*     the shards in turn, locking one at a time, so they see each
+*     shard consistently but not all shards at one instant.
+*
+* Required Files:
+* ---------------
+* ShardedProperty.h, Property.h, Property.cpp,
+* CustomContTypeTraits.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - shards are chosen with T's hasher when T has one
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include "../CustomContainerTypeTraits/CustomContTypeTraits.h"
+
+///////////////////////////////////////////////////////////////
+// shard_hasher<T>
+// - T's own hasher for unordered containers, so keys with a
+//   custom hasher and no std::hash specialization work
+
+template<typename T, typename = void>
+struct shard_hasher { using type = std::hash<typename T::key_type>; };
+template<typename T>
+struct shard_hasher<T, std::void_t<typename T::hasher>> { using type = typename T::hasher; };
+
+///////////////////////////////////////////////////////////////
+// ShardedProperty<T, N> class
+// - find returns a copy of the item, not an iterator, since an
+//   iterator would refer into a shard after its lock is released
+// - each shard sits on its own cache line so locking one shard
+//   doesn't disturb its neighbors
+
+template<typename T, size_t N = 16>
+class ShardedProperty
+{
+  static_assert(is_stl_assoc_container<T>::value, "ShardedProperty<T, N> requires an STL associative container");
+  static_assert(N > 0, "ShardedProperty<T, N> requires at least one shard");
+public:
+  using key_type = typename T::key_type;
+  using value_type = typename T::value_type;
+
+  ShardedProperty() {}
+  ShardedProperty(const T& t)
+  {
+    for (auto& item : t)
+      insert(item);
+  }
+
+  ShardedProperty(const ShardedProperty<T, N>& prop) = delete;
+  ShardedProperty<T, N>& operator=(const ShardedProperty<T, N>& prop) = delete;
+
+  //----< returns true if value was inserted >-------------
+
+  bool insert(const value_type& value)
+  {
+    Shard& shard = shardFor(keyOf(value));
+    std::lock_guard<std::mutex> lck(shard.mtx);
+    return insertInto(shard.t, value);
+  }
+
+  std::optional<value_type> find(const key_type& key) const
+  {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lck(shard.mtx);
+    auto found = shard.t.find(key);
+    if (found == shard.t.end())
+      return std::nullopt;
+    return *found;
+  }
+
+  bool contains(const key_type& key) const
+  {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lck(shard.mtx);
+    return shard.t.find(key) != shard.t.end();
+  }
+  //----< returns number of items erased >-----------------
+
+  size_t erase(const key_type& key)
+  {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lck(shard.mtx);
+    return shard.t.erase(key);
+  }
+
+  template<typename U = T>
+  const typename U::mapped_type operator[](const key_type& key) const
+  {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lck(shard.mtx);
+    auto found = shard.t.find(key);
+    if (found == shard.t.end())
+    {
+      std::invalid_argument exc("exception: key not found");
+      throw(exc);
+    }
+    return found->second;
+  }
+  /*
+  * - Same semantics as PropertyOps<T>::editItem:
+  *   returns false if { key, value } was created, true if an
+  *   existing item was edited
+  */
+  template<typename U = T>
+  bool editItem(const key_type& key, const typename U::mapped_type& value)
+  {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lck(shard.mtx);
+    auto iter = shard.t.find(key);
+    if (iter == shard.t.end())
+    {
+      shard.t.insert(value_type(key, value));
+      return false;
+    }
+    iter->second = value;
+    return true;
+  }
+
+  size_t size() const
+  {
+    size_t sz = 0;
+    for (Shard& shard : shards_)
+    {
+      std::lock_guard<std::mutex> lck(shard.mtx);
+      sz += shard.t.size();
+    }
+    return sz;
+  }
+  //----< call f(const value_type&) on every item >--------
+
+  template<typename F>
+  void for_each(F f) const
+  {
+    for (Shard& shard : shards_)
+    {
+      std::lock_guard<std::mutex> lck(shard.mtx);
+      for (auto& item : shard.t)
+        f(item);
+    }
+  }
+  //----< returns all items merged into one container >----
+
+  T operator()() const
+  {
+    T merged;
+    for_each([&merged](const value_type& item) { insertInto(merged, item); });
+    return merged;
+  }
+
+  static constexpr size_t shardCount() { return N; }
+
+private:
+  struct alignas(64) Shard
+  {
+    std::mutex mtx;
+    T t;
+  };
+
+  template<typename V>
+  static const key_type& keyOf(const V& value)
+  {
+    if constexpr (std::is_same<key_type, V>::value)
+      return value;        // sets
+    else
+      return value.first;  // maps
+  }
+
+  static bool insertInto(T& t, const value_type& value)
+  {
+    if constexpr (std::is_same<decltype(t.insert(value)), typename T::iterator>::value)
+    {
+      t.insert(value);     // multi-containers always insert
+      return true;
+    }
+    else
+    {
+      return t.insert(value).second;
+    }
+  }
+  //----< mix the key's hash so shard and bucket choices differ >--
+
+  Shard& shardFor(const key_type& key) const
+  {
+    std::uint64_t h = static_cast<std::uint64_t>(typename shard_hasher<T>::type()(key));
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return shards_[static_cast<size_t>(h % N)];
+  }
+
+  mutable std::array<Shard, N> shards_;
+};
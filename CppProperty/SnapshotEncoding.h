@@ -0,0 +1,475 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// SnapshotEncoding.h - Binary encoding of property values         //
+// ver 1.1 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package defines the value encoding used by PropertySnapshot.h
+* and PropertyJournal.h:
+* - Writer, Reader
+*     Write to an output stream or append to a std::string, and read
+*     from an input stream or a block of memory.  A Reader knows how
+*     many bytes it may read, when the stream is seekable, and
+*     section(n) gives a Reader limited to the next n bytes.
+* - writeValue(writer, t), readValue(reader, t)
+*     Encode and decode one value
+* - isEncodable<T>()
+*     True if writeValue and readValue support T
+*
+* Supported values are arithmetic and enum types, std::string, pairs,
+* the containers recognized by is_stl_seq_container and
+* is_stl_assoc_container, nested in any combination, and trivially
+* copyable types that opt in by specializing is_bitwise_encodable.
+* Pointers are never encoded, since their values mean nothing to
+* another process.
+* - Arrays of arithmetic, enum, and opted in elements, held by
+*   std::vector, std::array, and std::string, are written and read
+*   as one block.
+* - Reading sizes each container once before filling it, and
+*   inserts into ordered containers with an end hint, so sorted
+*   input costs constant time per element.
+* - A count read is checked against the bytes remaining before
+*   anything is sized, so corrupt input throws std::runtime_error
+*   instead of allocating without bound.  Streams that can't seek
+*   have no known end, so their counts aren't checked.
+*
+* Values are written in the machine's own byte order and sizes.
+* It doesn't include Property.h, so Property.h can include packages
+* that use it.
+*
+* Required Files:
+* ---------------
+* SnapshotEncoding.h, CustomContTypeTraits.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 17 Oct 2026
+* - Reader tracks the bytes remaining for streams too, and added
+*   skip(n) and section(n)
+* - trivially copyable types are only encoded if they opt in with
+*   is_bitwise_encodable, and never if they're pointers
+* - counts are checked against the bytes remaining
+* ver 1.0 : 17 Oct 2026
+* - first release, value encoding moved from PropertySnapshot.h
+*/
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <forward_list>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../CustomContainerTypeTraits/CustomContTypeTraits.h"
+
+namespace PropertySnapshot {
+
+  /////////////////////////////////////////////////////////////
+  // Writer and Reader classes
+  // - thin wrappers over a stream, or over memory, that turn
+  //   failures into exceptions
+
+  class Writer
+  {
+  public:
+    Writer(std::ostream& out) : pOut_(&out) {}
+    Writer(std::string& buffer) : pBuffer_(&buffer) {}
+
+    void write(const void* p, size_t n)
+    {
+      if (pBuffer_ != nullptr)
+      {
+        pBuffer_->append(static_cast<const char*>(p), n);
+        return;
+      }
+      pOut_->write(static_cast<const char*>(p), static_cast<std::streamsize>(n));
+      if (!*pOut_)
+        throw std::runtime_error("exception: snapshot write failed");
+    }
+    void writeSize(std::uint64_t n)
+    {
+      write(&n, sizeof(n));
+    }
+  private:
+    std::ostream* pOut_ = nullptr;
+    std::string* pBuffer_ = nullptr;
+  };
+
+  class Reader
+  {
+  public:
+    static constexpr size_t Unbounded = static_cast<size_t>(-1);
+
+    Reader(std::istream& in) : pIn_(&in), remaining_(streamRemaining(in)) {}
+    Reader(std::istream& in, size_t limit) : pIn_(&in), remaining_(limit) {}
+    Reader(const char* pData, size_t size) : pData_(pData), remaining_(size) {}
+
+    void read(void* p, size_t n)
+    {
+      consume(n);
+      if (pData_ != nullptr)
+      {
+        std::memcpy(p, pData_, n);
+        pData_ += n;
+        return;
+      }
+      pIn_->read(static_cast<char*>(p), static_cast<std::streamsize>(n));
+      if (static_cast<size_t>(pIn_->gcount()) != n)
+        throw std::runtime_error("exception: snapshot is truncated");
+    }
+    std::uint64_t readSize()
+    {
+      std::uint64_t n;
+      read(&n, sizeof(n));
+      return n;
+    }
+
+    void skip(size_t n)
+    {
+      consume(n);
+      if (pData_ != nullptr)
+      {
+        pData_ += n;
+        return;
+      }
+      pIn_->ignore(static_cast<std::streamsize>(n));
+      if (static_cast<size_t>(pIn_->gcount()) != n)
+        throw std::runtime_error("exception: snapshot is truncated");
+    }
+    //----< reader for the next n bytes, which this one skips >--
+    /*
+    *  Reading from a stream, the section reads the bytes itself,
+    *  so read them all before using this reader again.
+    */
+    Reader section(size_t n)
+    {
+      consume(n);
+      if (pData_ != nullptr)
+      {
+        Reader part(pData_, n);
+        pData_ += n;
+        return part;
+      }
+      return Reader(*pIn_, n);
+    }
+    //----< bytes left, or Unbounded if a stream's isn't known >--
+
+    size_t remaining() const
+    {
+      return remaining_;
+    }
+  private:
+    void consume(size_t n)
+    {
+      if (n > remaining_)
+        throw std::runtime_error("exception: snapshot is truncated");
+      if (remaining_ != Unbounded)
+        remaining_ -= n;
+    }
+
+    static size_t streamRemaining(std::istream& in)
+    {
+      std::istream::pos_type pos = in.tellg();
+      if (pos == std::istream::pos_type(-1))
+        return Unbounded;
+      in.seekg(0, std::ios::end);
+      std::istream::pos_type end = in.tellg();
+      if (!in || end == std::istream::pos_type(-1))
+      {
+        in.clear();
+        in.seekg(pos);
+        return Unbounded;
+      }
+      in.seekg(pos);
+      return static_cast<size_t>(end - pos);
+    }
+
+    std::istream* pIn_ = nullptr;
+    const char* pData_ = nullptr;
+    size_t remaining_ = 0;
+  };
+
+  /////////////////////////////////////////////////////////////
+  // is_bitwise_encodable<T>
+  // - specialize as std::true_type for a trivially copyable
+  //   struct of plain values to encode it as its bytes, e.g.,
+  //   template<> struct PropertySnapshot::is_bitwise_encodable<Tick>
+  //     : std::true_type {};
+  // - don't opt in types holding pointers or handles
+
+  template<typename T> struct is_bitwise_encodable : std::false_type {};
+
+  namespace detail {
+
+    template<typename T> struct is_pair : std::false_type {};
+    template<typename A, typename B> struct is_pair<std::pair<A, B>> : std::true_type {};
+
+    template<typename T> struct is_std_array : std::false_type {};
+    template<typename E, size_t N> struct is_std_array<std::array<E, N>> : std::true_type {};
+
+    template<typename T> struct is_vector_bool : std::false_type {};
+    template<typename A> struct is_vector_bool<std::vector<bool, A>> : std::true_type {};
+
+    template<typename T, typename = void> struct is_adapter : std::false_type {};
+    template<typename T> struct is_adapter<T, std::void_t<typename T::container_type>> : std::true_type {};
+
+    template<typename T, typename = void> struct is_map : std::false_type {};
+    template<typename T> struct is_map<T, std::void_t<typename T::mapped_type>> : std::true_type {};
+
+    template<typename T, typename = void> struct has_data : std::false_type {};
+    template<typename T> struct has_data<T, std::void_t<decltype(std::declval<T&>().data())>> : std::true_type {};
+
+    template<typename T> struct dependent_false : std::false_type {};
+
+    //----< values encoded as their bytes >------------------
+
+    template<typename T>
+    constexpr bool isBitwise()
+    {
+      if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+        return true;
+      else
+        return is_bitwise_encodable<T>::value && std::is_trivially_copyable<T>::value
+          && !std::is_pointer<T>::value && !std::is_member_pointer<T>::value;
+    }
+    //----< elements that can be copied as one block >-------
+
+    template<typename C>
+    constexpr bool isBulk()
+    {
+      return has_data<C>::value && !is_vector_bool<C>::value && isBitwise<typename C::value_type>();
+    }
+    //----< fewest bytes an encoded T can occupy >-----------
+
+    template<typename T>
+    constexpr size_t minEncodedSize()
+    {
+      if constexpr (is_pair<T>::value)
+        return minEncodedSize<std::remove_const_t<typename T::first_type>>() + minEncodedSize<typename T::second_type>();
+      else if constexpr (isBitwise<T>())
+        return sizeof(T);
+      else
+        return sizeof(std::uint64_t);
+    }
+    //----< read a count of E, no more than could remain >---
+
+    template<typename E>
+    size_t readCount(Reader& in)
+    {
+      std::uint64_t n = in.readSize();
+      if (n > in.remaining() / minEncodedSize<E>())
+        throw std::runtime_error("exception: snapshot is corrupt, a count exceeds the bytes remaining");
+      return static_cast<size_t>(n);
+    }
+    //----< access the container held by an adapter >--------
+    /*
+    *  stack, queue, and priority_queue keep it in protected
+    *  member c.  A priority_queue's container is already in
+    *  heap order, so restoring it directly keeps that order.
+    */
+    template<typename A>
+    struct AdapterAccess : A
+    {
+      static const typename A::container_type& get(const A& a)
+      {
+        return a.*(&AdapterAccess::c);
+      }
+      static typename A::container_type& get(A& a)
+      {
+        return a.*(&AdapterAccess::c);
+      }
+    };
+  }
+
+  //----< true if writeValue and readValue support T >----------
+
+  template<typename T>
+  constexpr bool isEncodable()
+  {
+    if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_same<T, std::string>::value)
+      return true;
+    else if constexpr (detail::is_pair<T>::value)
+      return isEncodable<std::remove_const_t<typename T::first_type>>() && isEncodable<typename T::second_type>();
+    else if constexpr (detail::is_adapter<T>::value)
+      return isEncodable<typename T::container_type>();
+    else if constexpr (is_stl_seq_container<T>::value)
+      return isEncodable<typename T::value_type>();
+    else if constexpr (is_stl_assoc_container<T>::value && detail::is_map<T>::value)
+      return isEncodable<typename T::key_type>() && isEncodable<typename T::mapped_type>();
+    else if constexpr (is_stl_assoc_container<T>::value)
+      return isEncodable<typename T::key_type>();
+    else
+      return detail::isBitwise<T>();
+  }
+
+  template<typename T> void writeValue(Writer& out, const T& t);
+  template<typename T> void readValue(Reader& in, T& t);
+
+  /////////////////////////////////////////////////////////////
+  // value encoding
+  // - fixed size values are written as their bytes
+  // - strings and containers are a 64 bit count followed by
+  //   their elements
+
+  template<typename T>
+  void writeValue(Writer& out, const T& t)
+  {
+    if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+    {
+      out.write(&t, sizeof(T));
+    }
+    else if constexpr (std::is_same<T, std::string>::value)
+    {
+      out.writeSize(t.size());
+      out.write(t.data(), t.size());
+    }
+    else if constexpr (detail::is_pair<T>::value)
+    {
+      writeValue(out, t.first);
+      writeValue(out, t.second);
+    }
+    else if constexpr (detail::is_adapter<T>::value)
+    {
+      writeValue(out, detail::AdapterAccess<T>::get(t));
+    }
+    else if constexpr (is_stl_seq_container<T>::value)
+    {
+      if constexpr (std::is_same<T, std::forward_list<typename T::value_type>>::value)
+        out.writeSize(static_cast<std::uint64_t>(std::distance(t.begin(), t.end())));
+      else
+        out.writeSize(t.size());
+      if constexpr (detail::isBulk<T>())
+      {
+        out.write(t.data(), t.size() * sizeof(typename T::value_type));
+      }
+      else
+      {
+        for (const auto& item : t)
+          writeValue(out, static_cast<const typename T::value_type&>(item));
+      }
+    }
+    else if constexpr (is_stl_assoc_container<T>::value)
+    {
+      out.writeSize(t.size());
+      for (const auto& item : t)
+      {
+        if constexpr (detail::is_map<T>::value)
+        {
+          writeValue(out, item.first);
+          writeValue(out, item.second);
+        }
+        else
+        {
+          writeValue(out, item);
+        }
+      }
+    }
+    else if constexpr (detail::isBitwise<T>())
+    {
+      out.write(&t, sizeof(T));
+    }
+    else
+    {
+      static_assert(detail::dependent_false<T>::value, "PropertySnapshot doesn't support this type");
+    }
+  }
+
+  template<typename T>
+  void readValue(Reader& in, T& t)
+  {
+    if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+    {
+      in.read(&t, sizeof(T));
+    }
+    else if constexpr (std::is_same<T, std::string>::value)
+    {
+      t.resize(detail::readCount<char>(in));
+      in.read(&t[0], t.size());
+    }
+    else if constexpr (detail::is_pair<T>::value)
+    {
+      readValue(in, t.first);
+      readValue(in, t.second);
+    }
+    else if constexpr (detail::is_adapter<T>::value)
+    {
+      readValue(in, detail::AdapterAccess<T>::get(t));
+    }
+    else if constexpr (detail::is_std_array<T>::value)
+    {
+      if (in.readSize() != t.size())
+        throw std::runtime_error("exception: snapshot array size doesn't match");
+      if constexpr (detail::isBulk<T>())
+        in.read(t.data(), t.size() * sizeof(typename T::value_type));
+      else
+        for (auto& item : t)
+          readValue(in, item);
+    }
+    else if constexpr (detail::is_vector_bool<T>::value)
+    {
+      t.resize(detail::readCount<bool>(in));
+      for (size_t i = 0; i < t.size(); ++i)
+      {
+        bool b;
+        readValue(in, b);
+        t[i] = b;
+      }
+    }
+    else if constexpr (is_stl_seq_container<T>::value)
+    {
+      t.resize(detail::readCount<typename T::value_type>(in));
+      if constexpr (detail::isBulk<T>())
+      {
+        in.read(t.data(), t.size() * sizeof(typename T::value_type));
+      }
+      else
+      {
+        for (auto& item : t)
+          readValue(in, item);
+      }
+    }
+    else if constexpr (is_stl_assoc_container<T>::value)
+    {
+      using key_type = typename T::key_type;
+      using item_type = std::conditional_t<detail::is_map<T>::value, typename T::value_type, key_type>;
+      t.clear();
+      size_t n = detail::readCount<item_type>(in);
+      if constexpr (has_reserve<T>::value)
+        t.reserve(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        key_type key;
+        readValue(in, key);
+        if constexpr (detail::is_map<T>::value)
+        {
+          typename T::mapped_type mapped;
+          readValue(in, mapped);
+          t.emplace_hint(t.end(), std::move(key), std::move(mapped));
+        }
+        else
+        {
+          t.emplace_hint(t.end(), std::move(key));
+        }
+      }
+    }
+    else if constexpr (detail::isBitwise<T>())
+    {
+      in.read(&t, sizeof(T));
+    }
+    else
+    {
+      static_assert(detail::dependent_false<T>::value, "PropertySnapshot doesn't support this type");
+    }
+  }
+}
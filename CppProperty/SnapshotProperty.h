@@ -0,0 +1,227 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// SnapshotProperty.h - Copy-on-write property for large values    //
+// ver 1.2 - 17 October 2026                                       //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2019                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a thread-safe property for large values,
+* e.g., containers, that are read far more often than written:
+* - SnapshotProperty<T>
+*     Holds an immutable version of its value through a
+*     std::shared_ptr<const T>.  Readers get that pointer, a
+*     snapshot, from a PublishedPtr, so reading is O(1) and never
+*     copies the value.  Writers build a new version and publish it.
+*     A retired version is destroyed when the last reader holding it
+*     drops its snapshot.
+*     Provides operator=(t), operator()(t), operator()(), snapshot(),
+*     modify(f), and version(), the number of versions published.
+* - PublishedPtr<E>
+*     Holds a std::shared_ptr<E> that one writer at a time replaces
+*     with store(p) while any number of readers copy it with load().
+*     load() takes no lock: it counts itself in as a reader of the
+*     current slot, copies the pointer, and counts itself out.
+*     store(p) fills the other slot, switches readers to it, and
+*     waits for readers still copying from the old slot to finish.
+*
+* Readers never take a mutex.  std::atomic_load on a shared_ptr
+* isn't used because libstdc++ implements it with a mutex from a
+* pool shared by every shared_ptr in the program.
+*
+* Required Files:
+* ---------------
+* SnapshotProperty.h, Property.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 17 Oct 2026
+* - added PublishedPtr, replacing std::atomic_load and atomic_store,
+*   which take a pooled mutex on some standard libraries
+* ver 1.1 : 17 Oct 2026
+* - added version()
+* ver 1.0 : 17 Oct 2026
+* - first release
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+///////////////////////////////////////////////////////////////
+// PublishedPtr<E> class
+// - callers serialize store(); load() may run on any thread at
+//   any time
+// - a reader that finds current_ changed after counting itself
+//   in may be counted in the slot being refilled, so it counts
+//   itself out and retries without touching the slot
+// - the reader count and the slot index use sequentially
+//   consistent operations: a writer that sees no readers of the
+//   old slot knows any later reader will see the switch
+
+template<typename E>
+class PublishedPtr
+{
+public:
+  using pointer = std::shared_ptr<E>;
+
+  PublishedPtr(pointer p = nullptr)
+  {
+    slots_[0] = std::move(p);
+  }
+
+  PublishedPtr(const PublishedPtr&) = delete;
+  PublishedPtr& operator=(const PublishedPtr&) = delete;
+
+  //----< copy the current pointer without taking a lock >---
+
+  pointer load() const
+  {
+    for (;;)
+    {
+      unsigned slot = current_.load();
+      readers_[slot].count.fetch_add(1);
+      if (current_.load() == slot)
+      {
+        pointer p = slots_[slot];
+        readers_[slot].count.fetch_sub(1, std::memory_order_release);
+        return p;
+      }
+      readers_[slot].count.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+  //----< publish p, caller holds the writers' lock >--------
+  /*
+  *  The old slot's readers hold it only for a pointer copy,
+  *  so the wait is short.  The replaced pointer is released
+  *  here, after they have finished.
+  */
+  void store(pointer p)
+  {
+    unsigned old = current_.load(std::memory_order_relaxed);
+    unsigned next = 1 - old;
+    slots_[next] = std::move(p);
+    current_.store(next);
+    for (size_t spins = 0; readers_[old].count.load() != 0; ++spins)
+    {
+      if (spins > 64)
+        std::this_thread::yield();
+    }
+    slots_[old].reset();
+  }
+
+private:
+  struct alignas(64) ReaderCount  // one cache line per slot's count
+  {
+    std::atomic<long> count { 0 };
+  };
+
+  pointer slots_[2];
+  std::atomic<unsigned> current_ { 0 };
+  mutable ReaderCount readers_[2];
+};
+
+///////////////////////////////////////////////////////////////
+// SnapshotProperty<T> class
+// - a snapshot stays valid, and unchanged, for as long as the
+//   reader holds it, regardless of later writes
+// - writers are serialized so modify(f) doesn't lose updates
+
+template<typename T>
+class SnapshotProperty
+{
+public:
+  using value_type = T;
+  using snapshot_type = std::shared_ptr<const T>;
+
+  SnapshotProperty() : published_(std::make_shared<const T>()) {}
+  SnapshotProperty(const T& t) : published_(std::make_shared<const T>(t)) {}
+
+  SnapshotProperty(const SnapshotProperty<T>& prop) = delete;
+  SnapshotProperty<T>& operator=(const SnapshotProperty<T>& prop) = delete;
+
+  SnapshotProperty<T>& operator=(const T& t)
+  {
+    set(t);
+    return *this;
+  }
+  void operator()(const T& t)
+  {
+    set(t);
+  }
+  //----< returns current version without copying it >-----
+
+  snapshot_type operator()() const
+  {
+    return snapshot();
+  }
+
+  snapshot_type snapshot() const
+  {
+    return published_.load();
+  }
+  //----< number of versions published since construction >--
+  /*
+  *  Read before snapshot(), so the snapshot is at least as
+  *  new as the version.
+  */
+  std::uint64_t version() const
+  {
+    return version_.load(std::memory_order_acquire);
+  }
+  //----< publish t as the new version >-------------------
+
+  void set(const T& t)
+  {
+    snapshot_type pNew = std::make_shared<const T>(t);
+    std::lock_guard<std::mutex> lck(writeMtx_);
+    published_.store(std::move(pNew));
+    published();
+  }
+  //----< copy current version, apply f, publish result >--
+  /*
+  *  f is called with a T& referring to a private copy, so
+  *  readers never see a partially modified value.  Returns
+  *  whatever f returns.
+  */
+  template<typename F>
+  auto modify(F f)
+  {
+    std::lock_guard<std::mutex> lck(writeMtx_);
+    std::shared_ptr<T> pNew = std::make_shared<T>(*published_.load());
+    if constexpr (std::is_void<decltype(f(*pNew))>::value)
+    {
+      f(*pNew);
+      published_.store(snapshot_type(std::move(pNew)));
+      published();
+    }
+    else
+    {
+      auto result = f(*pNew);
+      published_.store(snapshot_type(std::move(pNew)));
+      published();
+      return result;
+    }
+  }
+
+private:
+  //----< writers call holding writeMtx_ >-----------------
+
+  void published()
+  {
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  PublishedPtr<const T> published_;
+  std::atomic<std::uint64_t> version_ { 0 };
+  std::mutex writeMtx_;
+};
@@ -43,6 +43,13 @@ int main()
 
   std::cout << "\n  is_stl_assoc_container<int>::value: ";
   std::cout << is_stl_assoc_container<int>::value;
+  std::cout << std::endl;
+
+  std::cout << "\n  has_reserve<std::vector<int>>::value: ";
+  std::cout << has_reserve<std::vector<int>>::value;
+
+  std::cout << "\n  has_reserve<std::deque<int>>::value: ";
+  std::cout << has_reserve<std::deque<int>>::value;
 
   std::cout << "\n\n";
   return 0;
@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // CustomContTypeTraits.h - Defines type traits for stl containers //
-// ver 1.0 - 18 August 2019                                        //
+// ver 1.1 - 17 October 2026                                       //
 //-----------------------------------------------------------------//
 // Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
 /////////////////////////////////////////////////////////////////////
@@ -16,6 +16,7 @@
 * - is_stl_container
 * - is_stl_seq_container
 * - is_stl_assoc_container
+* - has_reserve
 *
 * Required Files:
 * ---------------
@@ -24,6 +25,8 @@
 *
 * Maintenance History:
 * --------------------
+* ver 1.1 : 17 Oct 2026
+* - added has_reserve
 * ver 1.0 : 18 Aug 2019
 * - first release
 */
@@ -108,3 +111,7 @@ namespace is_stl_assoc_container_impl {
 template <typename T> struct is_stl_assoc_container {
   static constexpr bool const value = is_stl_assoc_container_impl::is_stl_assoc_container<std::decay_t<T>>::value;
 };
+
+//detect containers that can reserve capacity, e.g., std::vector and std::string
+template <typename T, typename = void> struct has_reserve :std::false_type {};
+template <typename T> struct has_reserve<T, std::void_t<decltype(std::declval<T&>().reserve(std::size_t()))>> :std::true_type {};